@@ -33,6 +33,16 @@ namespace GraphicsMagick
 		static GraphicsMagickNET()
 		{
 		}
+		private static object CastIEnumerable(IEnumerable<MagickFormat> formats)
+		{
+			if (ReferenceEquals(formats, null))
+				return null;
+			Type listType = typeof(List<>).MakeGenericType(Types.MagickFormat);
+			object result = listType.CreateInstance();
+			foreach (MagickFormat item in formats)
+				result.CallMethod("Add", Enum.ToObject(Types.MagickFormat, (int)item));
+			return result;
+		}
 		private static Delegate _LogDelegate;
 		private static EventHandler<LogEventArgs> _Log;
 		private static object HandleLogEvent(object[] args)
@@ -111,6 +121,17 @@ namespace GraphicsMagick
 			}
 			return (result == null ? null : new MagickFormatInfo(result));
 		}
+		public static void Initialize()
+		{
+			try
+			{
+				Types.GraphicsMagickNET.CallMethod("Initialize");
+			}
+			catch (Exception ex)
+			{
+				throw ExceptionHelper.Create(ex);
+			}
+		}
 		public static void Initialize(String path)
 		{
 			try
@@ -155,5 +176,18 @@ namespace GraphicsMagick
 				throw ExceptionHelper.Create(ex);
 			}
 		}
+		public static TimeSpan WarmUp(IEnumerable<MagickFormat> formats, WarmUpOptions options)
+		{
+			object result;
+			try
+			{
+				result = Types.GraphicsMagickNET.CallMethod("WarmUp", new Type[] {Types.IEnumerableMagickFormat, Types.WarmUpOptions}, CastIEnumerable(formats), options);
+			}
+			catch (Exception ex)
+			{
+				throw ExceptionHelper.Create(ex);
+			}
+			return (TimeSpan)result;
+		}
 	}
 }
@@ -84,6 +84,60 @@ namespace GraphicsMagick
 				}
 			}
 		}
+		public String DecodedCacheDirectory
+		{
+			get
+			{
+				object result;
+				try
+				{
+					result = _Instance.GetPropertyValue("DecodedCacheDirectory");
+				}
+				catch (Exception ex)
+				{
+					throw ExceptionHelper.Create(ex);
+				}
+				return (String)result;
+			}
+			set
+			{
+				try
+				{
+					_Instance.SetPropertyValue("DecodedCacheDirectory", value);
+				}
+				catch (Exception ex)
+				{
+					throw ExceptionHelper.Create(ex);
+				}
+			}
+		}
+		public DecodedCachePolicy DecodedCachePolicy
+		{
+			get
+			{
+				object result;
+				try
+				{
+					result = _Instance.GetPropertyValue("DecodedCachePolicy");
+				}
+				catch (Exception ex)
+				{
+					throw ExceptionHelper.Create(ex);
+				}
+				return (DecodedCachePolicy)result;
+			}
+			set
+			{
+				try
+				{
+					_Instance.SetPropertyValue("DecodedCachePolicy", value);
+				}
+				catch (Exception ex)
+				{
+					throw ExceptionHelper.Create(ex);
+				}
+			}
+		}
 		public MagickGeometry Density
 		{
 			get
@@ -269,5 +323,18 @@ namespace GraphicsMagick
 				throw ExceptionHelper.Create(ex);
 			}
 		}
+		public override String ToString()
+		{
+			object result;
+			try
+			{
+				result = _Instance.CallMethod("ToString");
+			}
+			catch (Exception ex)
+			{
+				throw ExceptionHelper.Create(ex);
+			}
+			return (String)result;
+		}
 	}
 }
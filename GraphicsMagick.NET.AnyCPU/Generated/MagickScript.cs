@@ -97,6 +97,37 @@ namespace GraphicsMagick
 				}
 			}
 		}
+		private Delegate _TraceDelegate;
+		private EventHandler<ScriptTraceEventArgs> _Trace;
+		private object HandleTraceEvent(object[] args)
+		{
+			if (_Trace != null)
+				_Trace(this, new ScriptTraceEventArgs(args[1]));
+			return null;
+		}
+		public event EventHandler<ScriptTraceEventArgs> Trace
+		{
+			add
+			{
+				if (_Trace == null)
+				{
+					EventInfo eventInfo = Types.MagickScript.GetEvent("Trace", BindingFlags.Public | BindingFlags.Instance);
+					if (_TraceDelegate == null)
+						_TraceDelegate = eventInfo.EventHandlerType.BuildDynamicHandler(HandleTraceEvent);
+					eventInfo.GetAddMethod(true).Invoke(_Instance, new object[] { _TraceDelegate });
+				}
+				_Trace += value;
+			}
+			remove
+			{
+				_Trace -= value;
+				if (_Trace == null)
+				{
+					EventInfo eventInfo = Types.MagickScript.GetEvent("Trace", BindingFlags.Public | BindingFlags.Instance);
+					eventInfo.GetRemoveMethod(true).Invoke(_Instance, new object[] { _TraceDelegate });
+				}
+			}
+		}
 		private Delegate _WriteDelegate;
 		private EventHandler<ScriptWriteEventArgs> _Write;
 		private object HandleWriteEvent(object[] args)
@@ -128,6 +159,60 @@ namespace GraphicsMagick
 				}
 			}
 		}
+		public Int32 MaxDegreeOfParallelism
+		{
+			get
+			{
+				object result;
+				try
+				{
+					result = _Instance.GetPropertyValue("MaxDegreeOfParallelism");
+				}
+				catch (Exception ex)
+				{
+					throw ExceptionHelper.Create(ex);
+				}
+				return (Int32)result;
+			}
+			set
+			{
+				try
+				{
+					_Instance.SetPropertyValue("MaxDegreeOfParallelism", value);
+				}
+				catch (Exception ex)
+				{
+					throw ExceptionHelper.Create(ex);
+				}
+			}
+		}
+		public Int32 TraceInterval
+		{
+			get
+			{
+				object result;
+				try
+				{
+					result = _Instance.GetPropertyValue("TraceInterval");
+				}
+				catch (Exception ex)
+				{
+					throw ExceptionHelper.Create(ex);
+				}
+				return (Int32)result;
+			}
+			set
+			{
+				try
+				{
+					_Instance.SetPropertyValue("TraceInterval", value);
+				}
+				catch (Exception ex)
+				{
+					throw ExceptionHelper.Create(ex);
+				}
+			}
+		}
 		public ScriptVariables Variables
 		{
 			get
@@ -144,6 +229,17 @@ namespace GraphicsMagick
 				return (result == null ? null : new ScriptVariables(result));
 			}
 		}
+		public void Compile()
+		{
+			try
+			{
+				_Instance.CallMethod("Compile");
+			}
+			catch (Exception ex)
+			{
+				throw ExceptionHelper.Create(ex);
+			}
+		}
 		public void Execute(MagickImage image)
 		{
 			try
@@ -168,5 +264,18 @@ namespace GraphicsMagick
 			}
 			return (result == null ? null : new MagickImage(result));
 		}
+		public IDictionary<String,Exception> ExecuteBatch(IEnumerable<String> fileNames, Int32 degreeOfParallelism)
+		{
+			object result;
+			try
+			{
+				result = _Instance.CallMethod("ExecuteBatch", new Type[] {typeof(IEnumerable<String>), typeof(Int32)}, fileNames, degreeOfParallelism);
+			}
+			catch (Exception ex)
+			{
+				throw ExceptionHelper.Create(ex);
+			}
+			return (IDictionary<String,Exception>)result;
+		}
 	}
 }
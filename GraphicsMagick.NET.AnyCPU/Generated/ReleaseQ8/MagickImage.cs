@@ -2446,6 +2446,50 @@ namespace GraphicsMagick
 				throw ExceptionHelper.Create(ex);
 			}
 		}
+		public void ExportPixels(YuvFormat format, IntPtr destination)
+		{
+			try
+			{
+				_Instance.CallMethod("ExportPixels", new Type[] {Types.YuvFormat, typeof(IntPtr)}, format, destination);
+			}
+			catch (Exception ex)
+			{
+				throw ExceptionHelper.Create(ex);
+			}
+		}
+		public void ExportPixels(YuvFormat format, Byte[] destination)
+		{
+			try
+			{
+				_Instance.CallMethod("ExportPixels", new Type[] {Types.YuvFormat, typeof(Byte[])}, format, destination);
+			}
+			catch (Exception ex)
+			{
+				throw ExceptionHelper.Create(ex);
+			}
+		}
+		public void ExportPixels(Int32 x, Int32 y, Int32 width, Int32 height, String map, StorageType storageType, IntPtr destination, Int32 stride)
+		{
+			try
+			{
+				_Instance.CallMethod("ExportPixels", new Type[] {typeof(Int32), typeof(Int32), typeof(Int32), typeof(Int32), typeof(String), Types.StorageType, typeof(IntPtr), typeof(Int32)}, x, y, width, height, map, storageType, destination, stride);
+			}
+			catch (Exception ex)
+			{
+				throw ExceptionHelper.Create(ex);
+			}
+		}
+		public void ExportPixels(Int32 x, Int32 y, Int32 width, Int32 height, String map, StorageType storageType, Byte[] destination, Int32 stride)
+		{
+			try
+			{
+				_Instance.CallMethod("ExportPixels", new Type[] {typeof(Int32), typeof(Int32), typeof(Int32), typeof(Int32), typeof(String), Types.StorageType, typeof(Byte[]), typeof(Int32)}, x, y, width, height, map, storageType, destination, stride);
+			}
+			catch (Exception ex)
+			{
+				throw ExceptionHelper.Create(ex);
+			}
+		}
 		public void Extent(MagickGeometry geometry, Gravity gravity, MagickColor backgroundColor)
 		{
 			try
@@ -3092,6 +3136,17 @@ namespace GraphicsMagick
 				throw ExceptionHelper.Create(ex);
 			}
 		}
+		public void LoadDecodedCache(String fileName)
+		{
+			try
+			{
+				_Instance.CallMethod("LoadDecodedCache", new Type[] {typeof(String)}, fileName);
+			}
+			catch (Exception ex)
+			{
+				throw ExceptionHelper.Create(ex);
+			}
+		}
 		public void Lower(Int32 size)
 		{
 			try
@@ -3461,6 +3516,28 @@ namespace GraphicsMagick
 				throw ExceptionHelper.Create(ex);
 			}
 		}
+		public void Read(IntPtr data, Int32 width, Int32 height, YuvFormat format)
+		{
+			try
+			{
+				_Instance.CallMethod("Read", new Type[] {typeof(IntPtr), typeof(Int32), typeof(Int32), Types.YuvFormat}, data, width, height, format);
+			}
+			catch (Exception ex)
+			{
+				throw ExceptionHelper.Create(ex);
+			}
+		}
+		public void Read(IntPtr data, Int32 width, Int32 height, String map, StorageType storageType, Int32 stride)
+		{
+			try
+			{
+				_Instance.CallMethod("Read", new Type[] {typeof(IntPtr), typeof(Int32), typeof(Int32), typeof(String), Types.StorageType, typeof(Int32)}, data, width, height, map, storageType, stride);
+			}
+			catch (Exception ex)
+			{
+				throw ExceptionHelper.Create(ex);
+			}
+		}
 		public void Read(FileInfo file, MagickReadSettings readSettings)
 		{
 			try
@@ -3681,6 +3758,17 @@ namespace GraphicsMagick
 				throw ExceptionHelper.Create(ex);
 			}
 		}
+		public void SaveDecodedCache(String fileName)
+		{
+			try
+			{
+				_Instance.CallMethod("SaveDecodedCache", new Type[] {typeof(String)}, fileName);
+			}
+			catch (Exception ex)
+			{
+				throw ExceptionHelper.Create(ex);
+			}
+		}
 		public void Scale(Percentage percentageWidth, Percentage percentageHeight)
 		{
 			try
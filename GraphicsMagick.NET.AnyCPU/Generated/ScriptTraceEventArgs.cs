@@ -0,0 +1,182 @@
+//=================================================================================================
+// Copyright 2017 Dirk Lemstra <https://graphicsmagick.codeplex.com/>
+//
+// Licensed under the ImageMagick License (the "License"); you may not use this file except in
+// compliance with the License. You may obtain a copy of the License at
+//
+//   http://www.imagemagick.org/script/license.php
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the
+// License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing permissions and
+// limitations under the License.
+//=================================================================================================
+using System;
+using System.Collections;
+using System.Collections.Generic;
+using System.Drawing;
+using System.Drawing.Drawing2D;
+using System.Drawing.Imaging;
+using System.IO;
+using System.Reflection;
+using System.Text;
+using System.Windows.Media.Imaging;
+using System.Xml;
+using System.Xml.Linq;
+using System.Xml.XPath;
+using Fasterflect;
+
+namespace GraphicsMagick
+{
+	public sealed class ScriptTraceEventArgs: EventArgs
+	{
+		internal object _Instance;
+		internal ScriptTraceEventArgs(object instance)
+		{
+			_Instance = instance;
+		}
+		public static object GetInstance(ScriptTraceEventArgs obj)
+		{
+			if (ReferenceEquals(obj, null))
+				return null;
+			return obj._Instance;
+		}
+		public static object GetInstance(object obj)
+		{
+			if (ReferenceEquals(obj, null))
+				return null;
+			ScriptTraceEventArgs casted = obj as ScriptTraceEventArgs;
+			if (ReferenceEquals(casted, null))
+				return obj;
+			return casted._Instance;
+		}
+		public TimeSpan Duration
+		{
+			get
+			{
+				object result;
+				try
+				{
+					result = _Instance.GetPropertyValue("Duration");
+				}
+				catch (Exception ex)
+				{
+					throw ExceptionHelper.Create(ex);
+				}
+				return (TimeSpan)result;
+			}
+		}
+		public Int32 Height
+		{
+			get
+			{
+				object result;
+				try
+				{
+					result = _Instance.GetPropertyValue("Height");
+				}
+				catch (Exception ex)
+				{
+					throw ExceptionHelper.Create(ex);
+				}
+				return (Int32)result;
+			}
+		}
+		public Int64 MemoryDelta
+		{
+			get
+			{
+				object result;
+				try
+				{
+					result = _Instance.GetPropertyValue("MemoryDelta");
+				}
+				catch (Exception ex)
+				{
+					throw ExceptionHelper.Create(ex);
+				}
+				return (Int64)result;
+			}
+		}
+		public String Name
+		{
+			get
+			{
+				object result;
+				try
+				{
+					result = _Instance.GetPropertyValue("Name");
+				}
+				catch (Exception ex)
+				{
+					throw ExceptionHelper.Create(ex);
+				}
+				return (String)result;
+			}
+		}
+		public Int32 OriginalHeight
+		{
+			get
+			{
+				object result;
+				try
+				{
+					result = _Instance.GetPropertyValue("OriginalHeight");
+				}
+				catch (Exception ex)
+				{
+					throw ExceptionHelper.Create(ex);
+				}
+				return (Int32)result;
+			}
+		}
+		public Int32 OriginalWidth
+		{
+			get
+			{
+				object result;
+				try
+				{
+					result = _Instance.GetPropertyValue("OriginalWidth");
+				}
+				catch (Exception ex)
+				{
+					throw ExceptionHelper.Create(ex);
+				}
+				return (Int32)result;
+			}
+		}
+		public TimeSpan ProcessorTime
+		{
+			get
+			{
+				object result;
+				try
+				{
+					result = _Instance.GetPropertyValue("ProcessorTime");
+				}
+				catch (Exception ex)
+				{
+					throw ExceptionHelper.Create(ex);
+				}
+				return (TimeSpan)result;
+			}
+		}
+		public Int32 Width
+		{
+			get
+			{
+				object result;
+				try
+				{
+					result = _Instance.GetPropertyValue("Width");
+				}
+				catch (Exception ex)
+				{
+					throw ExceptionHelper.Create(ex);
+				}
+				return (Int32)result;
+			}
+		}
+	}
+}
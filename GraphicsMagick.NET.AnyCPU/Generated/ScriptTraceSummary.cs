@@ -0,0 +1,82 @@
+//=================================================================================================
+// Copyright 2017 Dirk Lemstra <https://graphicsmagick.codeplex.com/>
+//
+// Licensed under the ImageMagick License (the "License"); you may not use this file except in
+// compliance with the License. You may obtain a copy of the License at
+//
+//   http://www.imagemagick.org/script/license.php
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the
+// License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing permissions and
+// limitations under the License.
+//=================================================================================================
+using System;
+using System.Collections;
+using System.Collections.Generic;
+using System.Drawing;
+using System.Drawing.Drawing2D;
+using System.Drawing.Imaging;
+using System.IO;
+using System.Reflection;
+using System.Text;
+using System.Windows.Media.Imaging;
+using System.Xml;
+using System.Xml.Linq;
+using System.Xml.XPath;
+using Fasterflect;
+
+namespace GraphicsMagick
+{
+	public sealed class ScriptTraceSummary
+	{
+		internal object _Instance;
+		internal ScriptTraceSummary(object instance)
+		{
+			_Instance = instance;
+		}
+		public static object GetInstance(ScriptTraceSummary obj)
+		{
+			if (ReferenceEquals(obj, null))
+				return null;
+			return obj._Instance;
+		}
+		public static object GetInstance(object obj)
+		{
+			if (ReferenceEquals(obj, null))
+				return null;
+			ScriptTraceSummary casted = obj as ScriptTraceSummary;
+			if (ReferenceEquals(casted, null))
+				return obj;
+			return casted._Instance;
+		}
+		public ScriptTraceSummary()
+			: this(AssemblyHelper.CreateInstance(Types.ScriptTraceSummary))
+		{
+		}
+		public void Add(Object sender, ScriptTraceEventArgs arguments)
+		{
+			try
+			{
+				_Instance.CallMethod("Add", new Type[] {typeof(Object), Types.ScriptTraceEventArgs}, GraphicsMagick.ScriptTraceSummary.GetInstance(sender), GraphicsMagick.ScriptTraceEventArgs.GetInstance(arguments));
+			}
+			catch (Exception ex)
+			{
+				throw ExceptionHelper.Create(ex);
+			}
+		}
+		public override String ToString()
+		{
+			object result;
+			try
+			{
+				result = _Instance.CallMethod("ToString");
+			}
+			catch (Exception ex)
+			{
+				throw ExceptionHelper.Create(ex);
+			}
+			return (String)result;
+		}
+	}
+}
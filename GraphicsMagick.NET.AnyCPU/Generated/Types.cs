@@ -208,6 +208,16 @@ namespace GraphicsMagick
 				return _IEnumerableCoordinate;
 			}
 		}
+		private static Type _DecodedCachePolicy;
+		public static Type DecodedCachePolicy
+		{
+			get
+			{
+				if (_DecodedCachePolicy == null)
+					_DecodedCachePolicy = AssemblyHelper.GetType("GraphicsMagick.DecodedCachePolicy");
+				return _DecodedCachePolicy;
+			}
+		}
 		private static Type _DoubleMatrix;
 		public static Type DoubleMatrix
 		{
@@ -988,6 +998,16 @@ namespace GraphicsMagick
 				return _MagickFormat;
 			}
 		}
+		private static Type _IEnumerableMagickFormat;
+		public static Type IEnumerableMagickFormat
+		{
+			get
+			{
+				if (_IEnumerableMagickFormat == null)
+					_IEnumerableMagickFormat = typeof(IEnumerable<>).MakeGenericType(MagickFormat);
+				return _IEnumerableMagickFormat;
+			}
+		}
 		private static Type _NullableMagickFormat;
 		public static Type NullableMagickFormat
 		{
@@ -1508,6 +1528,26 @@ namespace GraphicsMagick
 				return _ScriptReadEventArgs;
 			}
 		}
+		private static Type _ScriptTraceEventArgs;
+		public static Type ScriptTraceEventArgs
+		{
+			get
+			{
+				if (_ScriptTraceEventArgs == null)
+					_ScriptTraceEventArgs = AssemblyHelper.GetType("GraphicsMagick.ScriptTraceEventArgs");
+				return _ScriptTraceEventArgs;
+			}
+		}
+		private static Type _ScriptTraceSummary;
+		public static Type ScriptTraceSummary
+		{
+			get
+			{
+				if (_ScriptTraceSummary == null)
+					_ScriptTraceSummary = AssemblyHelper.GetType("GraphicsMagick.ScriptTraceSummary");
+				return _ScriptTraceSummary;
+			}
+		}
 		private static Type _ScriptVariables;
 		public static Type ScriptVariables
 		{
@@ -1578,6 +1618,16 @@ namespace GraphicsMagick
 				return _VirtualPixelMethod;
 			}
 		}
+		private static Type _WarmUpOptions;
+		public static Type WarmUpOptions
+		{
+			get
+			{
+				if (_WarmUpOptions == null)
+					_WarmUpOptions = AssemblyHelper.GetType("GraphicsMagick.WarmUpOptions");
+				return _WarmUpOptions;
+			}
+		}
 		private static Type _WarningEventArgs;
 		public static Type WarningEventArgs
 		{
@@ -1608,6 +1658,16 @@ namespace GraphicsMagick
 				return _XmpProfile;
 			}
 		}
+		private static Type _YuvFormat;
+		public static Type YuvFormat
+		{
+			get
+			{
+				if (_YuvFormat == null)
+					_YuvFormat = AssemblyHelper.GetType("GraphicsMagick.YuvFormat");
+				return _YuvFormat;
+			}
+		}
 		private static Type _NullableBoolean;
 		public static Type NullableBoolean
 		{
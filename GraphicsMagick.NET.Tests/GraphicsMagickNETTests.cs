@@ -39,7 +39,13 @@ namespace GraphicsMagick.NET.Tests
 
 				MagickFormatInfo formatInfo = GraphicsMagickNET.GetFormatInformation(format);
 				if (formatInfo == null)
+				{
 					missingFormats.Add(format.ToString());
+					continue;
+				}
+
+				Assert.AreEqual(format, formatInfo.Format);
+				Assert.AreSame(formatInfo, GraphicsMagickNET.GetFormatInformation(format));
 			}
 
 			if (missingFormats.Count > 0)
@@ -79,6 +85,17 @@ namespace GraphicsMagick.NET.Tests
 		}
 		//===========================================================================================
 		[TestMethod, TestCategory(_Category)]
+		public void Test_Initialize_Embedded()
+		{
+			GraphicsMagickNET.Initialize();
+
+			// This color is not compiled into GraphicsMagick, it is only defined in the colors.mgk
+			// file that is embedded in the assembly.
+			MagickColor color = new MagickColor("GraphicsMagickNET");
+			Assert.AreEqual(new MagickColor("#010203"), color);
+		}
+		//===========================================================================================
+		[TestMethod, TestCategory(_Category)]
 		public void Test_Log()
 		{
 			using (MagickImage image = new MagickImage(Files.SnakewarePNG))
@@ -119,6 +136,7 @@ namespace GraphicsMagick.NET.Tests
 			foreach (MagickFormatInfo formatInfo in GraphicsMagickNET.SupportedFormats)
 			{
 				Assert.AreNotEqual(MagickFormat.Unknown, formatInfo.Format, "Unknown format: " + formatInfo.Description);
+				Assert.AreSame(formatInfo, GraphicsMagickNET.GetFormatInformation(formatInfo.Format));
 			}
 		}
 		//===========================================================================================
@@ -143,6 +161,21 @@ namespace GraphicsMagick.NET.Tests
 		}
 		//===========================================================================================
 		[TestMethod, TestCategory(_Category)]
+		public void Test_WarmUp()
+		{
+			ExceptionAssert.Throws<ArgumentNullException>(delegate()
+			{
+				GraphicsMagickNET.WarmUp(null, WarmUpOptions.All);
+			});
+
+			TimeSpan elapsed = GraphicsMagickNET.WarmUp(new MagickFormat[] { MagickFormat.Jpeg, MagickFormat.Png }, WarmUpOptions.All);
+			Assert.IsTrue(elapsed >= TimeSpan.Zero);
+
+			Assert.IsNotNull(GraphicsMagickNET.GetFormatInformation(MagickFormat.Jpeg));
+			Assert.IsNotNull(GraphicsMagickNET.GetFormatInformation(MagickFormat.Png));
+		}
+		//===========================================================================================
+		[TestMethod, TestCategory(_Category)]
 		public void Test_SetTempDirectory()
 		{
 			ExceptionAssert.Throws<ArgumentNullException>(delegate()
@@ -18,6 +18,7 @@ using System.Drawing;
 using System.Drawing.Imaging;
 using System.IO;
 using System.Linq;
+using System.Runtime.InteropServices;
 using GraphicsMagick;
 using Microsoft.VisualStudio.TestTools.UnitTesting;
 
@@ -74,6 +75,21 @@ namespace GraphicsMagick.NET.Tests
 			}
 		}
 		//===========================================================================================
+		private static byte ToU(int r, int g, int b)
+		{
+			return (byte)(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+		}
+		//===========================================================================================
+		private static byte ToV(int r, int g, int b)
+		{
+			return (byte)(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+		}
+		//===========================================================================================
+		private static byte ToY(Color color)
+		{
+			return (byte)(((66 * color.R + 129 * color.G + 25 * color.B + 128) >> 8) + 16);
+		}
+		//===========================================================================================
 		[TestMethod, TestCategory(_Category)]
 		public void Test_Attribute()
 		{
@@ -170,6 +186,48 @@ namespace GraphicsMagick.NET.Tests
 		}
 		//===========================================================================================
 		[TestMethod, TestCategory(_Category)]
+		public void Test_DecodedCache()
+		{
+			string fileName = Path.Combine(Path.GetTempPath(), "Test_DecodedCache.mpc");
+			string cacheFileName = Path.ChangeExtension(fileName, ".cache");
+
+			try
+			{
+				using (MagickImage image = new MagickImage(Files.SnakewarePNG))
+				{
+					ExceptionAssert.Throws<ArgumentNullException>(delegate()
+					{
+						image.SaveDecodedCache(null);
+					});
+
+					image.SaveDecodedCache(fileName);
+					Assert.AreEqual(MagickFormat.Png, image.Format);
+					Assert.IsTrue(File.Exists(cacheFileName));
+
+					using (MagickImage cached = new MagickImage())
+					{
+						ExceptionAssert.Throws<ArgumentNullException>(delegate()
+						{
+							cached.LoadDecodedCache(null);
+						});
+
+						cached.LoadDecodedCache(fileName);
+
+						Assert.AreEqual(MagickFormat.Png, cached.Format);
+						Assert.AreEqual(image.Width, cached.Width);
+						Assert.AreEqual(image.Height, cached.Height);
+						Assert.AreEqual(image.Signature, cached.Signature);
+					}
+				}
+			}
+			finally
+			{
+				File.Delete(fileName);
+				File.Delete(cacheFileName);
+			}
+		}
+		//===========================================================================================
+		[TestMethod, TestCategory(_Category)]
 		public void Test_Define()
 		{
 			using (MagickImage image = new MagickImage("logo:"))
@@ -213,6 +271,173 @@ namespace GraphicsMagick.NET.Tests
 		}
 		//===========================================================================================
 		[TestMethod, TestCategory(_Category)]
+		public void Test_ExportPixels()
+		{
+			using (MagickImage image = new MagickImage(Color.Red, 4, 3))
+			{
+				ExceptionAssert.Throws<ArgumentNullException>(delegate()
+				{
+					image.ExportPixels(0, 0, 2, 2, "RGB", StorageType.Char, (byte[])null, 6);
+				});
+
+				ExceptionAssert.Throws<ArgumentException>(delegate()
+				{
+					image.ExportPixels(0, 0, 2, 2, "RGB", StorageType.Char, new byte[12], 5);
+				});
+
+				ExceptionAssert.Throws<ArgumentException>(delegate()
+				{
+					image.ExportPixels(0, 0, 2, 2, "RGB", StorageType.Char, new byte[11], 6);
+				});
+
+				ExceptionAssert.Throws<ArgumentException>(delegate()
+				{
+					image.ExportPixels(3, 0, 2, 2, "RGB", StorageType.Char, new byte[12], 6);
+				});
+
+				byte[] bytes = new byte[16];
+				image.ExportPixels(1, 1, 2, 2, "BGR", StorageType.Char, bytes, 8);
+				CollectionAssert.AreEqual(new byte[] { 0, 0, 255, 0, 0, 255, 0, 0, 0, 0, 255, 0, 0, 255, 0, 0 }, bytes);
+
+				bytes = new byte[14];
+				image.ExportPixels(1, 1, 2, 2, "BGR", StorageType.Char, bytes, 8);
+				CollectionAssert.AreEqual(new byte[] { 0, 0, 255, 0, 0, 255, 0, 0, 0, 0, 255, 0, 0, 255 }, bytes);
+
+				float[] floats = new float[4];
+				GCHandle handle = GCHandle.Alloc(floats, GCHandleType.Pinned);
+				try
+				{
+					image.ExportPixels(0, 2, 1, 1, "RGBA", StorageType.Float, handle.AddrOfPinnedObject(), 16);
+					CollectionAssert.AreEqual(new float[] { 1.0f, 0.0f, 0.0f, 1.0f }, floats);
+				}
+				finally
+				{
+					handle.Free();
+				}
+			}
+		}
+		//===========================================================================================
+		[TestMethod, TestCategory(_Category)]
+		public void Test_ExportPixels_Yuv()
+		{
+			using (MagickImage image = new MagickImage(Color.Red, 4, 2))
+			{
+				ExceptionAssert.Throws<ArgumentException>(delegate()
+				{
+					image.ExportPixels(YuvFormat.I420, new byte[11]);
+				});
+
+				byte[] i420 = new byte[12];
+				image.ExportPixels(YuvFormat.I420, i420);
+				CollectionAssert.AreEqual(new byte[] { 82, 82, 82, 82, 82, 82, 82, 82, 90, 90, 240, 240 }, i420);
+
+				byte[] nv12 = new byte[12];
+				image.ExportPixels(YuvFormat.NV12, nv12);
+				CollectionAssert.AreEqual(new byte[] { 82, 82, 82, 82, 82, 82, 82, 82, 90, 240, 90, 240 }, nv12);
+
+				byte[] yuy2 = new byte[16];
+				image.ExportPixels(YuvFormat.YUY2, yuy2);
+				CollectionAssert.AreEqual(new byte[] { 82, 90, 82, 240, 82, 90, 82, 240, 82, 90, 82, 240, 82, 90, 82, 240 }, yuy2);
+
+				GCHandle handle = GCHandle.Alloc(nv12, GCHandleType.Pinned);
+				try
+				{
+					using (MagickImage result = new MagickImage())
+					{
+						ExceptionAssert.Throws<ArgumentException>(delegate()
+						{
+							result.Read(handle.AddrOfPinnedObject(), 3, 2, YuvFormat.NV12);
+						});
+
+						result.Read(handle.AddrOfPinnedObject(), 4, 2, YuvFormat.NV12);
+						Assert.AreEqual(4, result.Width);
+						Assert.AreEqual(2, result.Height);
+
+						using (PixelCollection pixels = result.GetReadOnlyPixels())
+						{
+							Color color = pixels.GetPixel(3, 1).ToColor();
+							Assert.AreEqual(255, color.R);
+							Assert.IsTrue(color.G <= 1);
+							Assert.AreEqual(0, color.B);
+						}
+					}
+				}
+				finally
+				{
+					handle.Free();
+				}
+			}
+		}
+		//===========================================================================================
+		[TestMethod, TestCategory(_Category)]
+		public void Test_ExportPixels_Yuv_Image()
+		{
+			using (MagickImage image = new MagickImage(Files.SnakewarePNG))
+			{
+				// The width is not a multiple of 16 so both the vectorized and the scalar code are used.
+				image.Crop(38, 4);
+				Assert.AreEqual(38, image.Width);
+				Assert.AreEqual(4, image.Height);
+
+				int width = image.Width;
+				int height = image.Height;
+				Color[] colors = new Color[width * height];
+				using (PixelCollection pixels = image.GetReadOnlyPixels())
+				{
+					for (int y = 0; y < height; y++)
+					{
+						for (int x = 0; x < width; x++)
+							colors[(y * width) + x] = pixels.GetPixel(x, y).ToColor();
+					}
+				}
+
+				byte[] i420 = new byte[width * height * 3 / 2];
+				image.ExportPixels(YuvFormat.I420, i420);
+
+				byte[] yuy2 = new byte[width * height * 2];
+				image.ExportPixels(YuvFormat.YUY2, yuy2);
+
+				int u = width * height;
+				int v = u + (u / 4);
+				for (int y = 0; y < height; y++)
+				{
+					for (int x = 0; x < width; x += 2)
+					{
+						Color first = colors[(y * width) + x];
+						Color second = colors[(y * width) + x + 1];
+
+						Assert.AreEqual(ToY(first), i420[(y * width) + x]);
+						Assert.AreEqual(ToY(second), i420[(y * width) + x + 1]);
+
+						int r = (first.R + second.R + 1) >> 1;
+						int g = (first.G + second.G + 1) >> 1;
+						int b = (first.B + second.B + 1) >> 1;
+
+						int offset = ((y * width) + x) * 2;
+						Assert.AreEqual(ToY(first), yuy2[offset]);
+						Assert.AreEqual(ToU(r, g, b), yuy2[offset + 1]);
+						Assert.AreEqual(ToY(second), yuy2[offset + 2]);
+						Assert.AreEqual(ToV(r, g, b), yuy2[offset + 3]);
+
+						if (y % 2 != 0)
+							continue;
+
+						Color third = colors[((y + 1) * width) + x];
+						Color fourth = colors[((y + 1) * width) + x + 1];
+
+						r = (first.R + second.R + third.R + fourth.R + 2) >> 2;
+						g = (first.G + second.G + third.G + fourth.G + 2) >> 2;
+						b = (first.B + second.B + third.B + fourth.B + 2) >> 2;
+
+						int chroma = (y / 2 * width / 2) + (x / 2);
+						Assert.AreEqual(ToU(r, g, b), i420[u + chroma]);
+						Assert.AreEqual(ToV(r, g, b), i420[v + chroma]);
+					}
+				}
+			}
+		}
+		//===========================================================================================
+		[TestMethod, TestCategory(_Category)]
 		public void Test_Extent()
 		{
 			using (MagickImage image = new MagickImage())
@@ -524,6 +749,77 @@ namespace GraphicsMagick.NET.Tests
 		}
 		//===========================================================================================
 		[TestMethod, TestCategory(_Category)]
+		public void Test_Read_Pointer()
+		{
+			// Two rows of two RGB pixels with two bytes of padding at the end of each row.
+			byte[] data = new byte[]
+				{
+					255, 0, 0, 0, 255, 0, 1, 1,
+					0, 0, 255, 255, 255, 255, 1, 1
+				};
+
+			GCHandle handle = GCHandle.Alloc(data, GCHandleType.Pinned);
+			try
+			{
+				IntPtr pointer = handle.AddrOfPinnedObject();
+
+				using (MagickImage image = new MagickImage())
+				{
+					ExceptionAssert.Throws<ArgumentException>(delegate()
+					{
+						image.Read(IntPtr.Zero, 2, 2, "RGB", StorageType.Char, 8);
+					});
+
+					ExceptionAssert.Throws<ArgumentException>(delegate()
+					{
+						image.Read(pointer, 2, 2, "RGB", StorageType.Char, 5);
+					});
+
+					image.Read(pointer, 2, 2, "RGB", StorageType.Char, 8);
+					Assert.AreEqual(2, image.Width);
+					Assert.AreEqual(2, image.Height);
+
+					Test_Pixel(image, 0, 0, new MagickColor("red"));
+					Test_Pixel(image, 1, 0, new MagickColor("lime"));
+					Test_Pixel(image, 0, 1, new MagickColor("blue"));
+					Test_Pixel(image, 1, 1, new MagickColor("white"));
+				}
+			}
+			finally
+			{
+				handle.Free();
+			}
+
+			// The stride does not have to be a multiple of the pixel size and the last row does not
+			// have to contain the padding.
+			data = new byte[]
+				{
+					255, 0, 0, 0, 255, 0, 1,
+					0, 0, 255, 255, 255, 255
+				};
+
+			handle = GCHandle.Alloc(data, GCHandleType.Pinned);
+			try
+			{
+				using (MagickImage image = new MagickImage())
+				{
+					image.Read(handle.AddrOfPinnedObject(), 2, 2, "RGB", StorageType.Char, 7);
+					Assert.AreEqual(2, image.Width);
+					Assert.AreEqual(2, image.Height);
+
+					Test_Pixel(image, 0, 0, new MagickColor("red"));
+					Test_Pixel(image, 1, 0, new MagickColor("lime"));
+					Test_Pixel(image, 0, 1, new MagickColor("blue"));
+					Test_Pixel(image, 1, 1, new MagickColor("white"));
+				}
+			}
+			finally
+			{
+				handle.Free();
+			}
+		}
+		//===========================================================================================
+		[TestMethod, TestCategory(_Category)]
 		public void Test_Resize()
 		{
 			using (MagickImage image = new MagickImage())
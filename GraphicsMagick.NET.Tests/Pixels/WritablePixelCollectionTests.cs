@@ -33,9 +33,34 @@ namespace GraphicsMagick.NET.Tests
 		//===========================================================================================
 		private const string _Category = "WritablePixelCollection";
 		//===========================================================================================
+		private static QuantumType Convert(byte value)
+		{
+#if Q8
+			return value;
+#elif Q16
+			return (QuantumType)(value * 257);
+#else
+#error Not implemented!
+#endif
+		}
+		//===========================================================================================
+		private static void Test_GetValues(WritablePixelCollection pixels, QuantumType[] expected)
+		{
+			QuantumType[] values = pixels.GetValues();
+			Assert.AreEqual(expected.Length, values.Length);
+
+			for (int i = 0; i < values.Length; i++)
+				Assert.AreEqual(expected[i], values[i], "Value at index {0} is incorrect.", i);
+		}
+		//===========================================================================================
 		private static void Test_PixelColor(PixelBaseCollection pixels, Color color)
 		{
-			var values = pixels.GetValue(0, 0);
+			Test_PixelColor(pixels, 0, 0, color);
+		}
+		//===========================================================================================
+		private static void Test_PixelColor(PixelBaseCollection pixels, int x, int y, Color color)
+		{
+			var values = pixels.GetValue(x, y);
 			Assert.AreEqual(5, values.Length);
 
 			MagickColor magickColor = new MagickColor(values[0], values[1], values[2], values[3]);
@@ -65,6 +90,37 @@ namespace GraphicsMagick.NET.Tests
 		}
 		//===========================================================================================
 		[TestMethod, TestCategory(_Category)]
+		public void Test_DisjointAreas()
+		{
+			using (MagickImage image = new MagickImage(Color.Red, 5, 10))
+			{
+				using (WritablePixelCollection top = image.GetWritablePixels(0, 0, 5, 5))
+				{
+					using (WritablePixelCollection bottom = image.GetWritablePixels(0, 5, 5, 5))
+					{
+						top.Set(0, 0, new QuantumType[] { 0, 0, 0, 0, 0 });
+						bottom.Set(0, 4, new QuantumType[] { 0, 0, Quantum.Max, 0, 0 });
+
+						top.Write();
+						bottom.Write();
+					}
+				}
+
+				using (PixelCollection pixels = image.GetReadOnlyPixels())
+				{
+					Test_PixelColor(pixels, 0, 0, Color.Black);
+					Test_PixelColor(pixels, 1, 0, Color.Red);
+					Test_PixelColor(pixels, 0, 9, Color.Blue);
+				}
+
+				using (WritablePixelCollection pixels = image.GetWritablePixels())
+				{
+					Test_PixelColor(pixels, 0, 5, Color.Red);
+				}
+			}
+		}
+		//===========================================================================================
+		[TestMethod, TestCategory(_Category)]
 		public void Test_GetValue()
 		{
 			using (MagickImage image = new MagickImage(Color.Red, 5, 10))
@@ -102,6 +158,7 @@ namespace GraphicsMagick.NET.Tests
 					Test_Set(pixels, new QuantumType[] { 0 });
 					Test_Set(pixels, new QuantumType[] { 0, 0 });
 					Test_Set(pixels, new QuantumType[] { 0, 0, 0 });
+					Test_Set(pixels, new QuantumType[(5 * 10 * 5) + 5]);
 
 					pixels.Set(new QuantumType[] { 0, 0, 0, 0, 0 });
 					Test_PixelColor(pixels, Color.Black);
@@ -136,6 +193,50 @@ namespace GraphicsMagick.NET.Tests
 			}
 		}
 		//===========================================================================================
+		[TestMethod, TestCategory(_Category)]
+		public void Test_Set_Values()
+		{
+			// The width is odd so the values do not fit exactly in the vectorized loops.
+			using (MagickImage image = new MagickImage(Color.Red, 7, 3))
+			{
+				using (WritablePixelCollection pixels = image.GetWritablePixels())
+				{
+					int length = pixels.Width * pixels.Height * pixels.Channels;
+					QuantumType[] expected = new QuantumType[length];
+
+					byte[] bytes = new byte[length];
+					for (int i = 0; i < length; i++)
+					{
+						bytes[i] = (byte)((i * 37) % 256);
+						expected[i] = Convert(bytes[i]);
+					}
+
+					pixels.Set(bytes);
+					Test_GetValues(pixels, expected);
+
+					ushort[] shorts = new ushort[length];
+					for (int i = 0; i < length; i++)
+					{
+						shorts[i] = (ushort)((i * 4099) % Quantum.Max);
+						expected[i] = (QuantumType)shorts[i];
+					}
+
+					pixels.Set(shorts);
+					Test_GetValues(pixels, expected);
+
+					double[] doubles = new double[length];
+					for (int i = 0; i < length; i++)
+					{
+						doubles[i] = (i * 3.5) % Quantum.Max;
+						expected[i] = (QuantumType)doubles[i];
+					}
+
+					pixels.Set(doubles);
+					Test_GetValues(pixels, expected);
+				}
+			}
+		}
+		//===========================================================================================
 	}
 	//==============================================================================================
 }
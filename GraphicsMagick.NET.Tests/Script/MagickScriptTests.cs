@@ -13,6 +13,7 @@
 //=================================================================================================
 
 using System;
+using System.Collections.Generic;
 using System.Drawing;
 using System.IO;
 using System.Linq;
@@ -45,6 +46,12 @@ namespace GraphicsMagick.NET.Tests
 			}
 		}
 		//===========================================================================================
+		private static IEnumerable<string> EnumerateAndFail()
+		{
+			yield return Files.ImageMagickJPG;
+			throw new IOException("The enumeration failed.");
+		}
+		//===========================================================================================
 		private void EventsScriptRead(object sender, ScriptReadEventArgs arguments)
 		{
 			Assert.AreEqual("read.id", arguments.Id);
@@ -98,6 +105,128 @@ namespace GraphicsMagick.NET.Tests
 		}
 		//===========================================================================================
 		[TestMethod, TestCategory(_Category)]
+		public void Test_Constructor_SameScript()
+		{
+			MagickScript first = new MagickScript(Files.VariablesScript);
+			MagickScript second = new MagickScript(Files.VariablesScript);
+
+			first.Variables["width"] = 100;
+			Assert.AreEqual(100, first.Variables["width"]);
+			Assert.IsNull(second.Variables["width"]);
+
+			ExceptionAssert.Throws<XmlSchemaValidationException>(delegate()
+			{
+				new MagickScript(Files.InvalidScript);
+			});
+
+			XmlDocument doc = new XmlDocument();
+			doc.LoadXml(@"<msl><read><resize width=""10"" height=""10""/></read></msl>");
+
+			using (MagickImage image = new MagickImage(Files.GraphicsMagickNETIconPNG))
+			{
+				new MagickScript(doc).Execute(image);
+				Assert.AreEqual(10, image.Width);
+			}
+
+			XmlElement resize = (XmlElement)doc.SelectSingleNode("/msl/read/resize");
+			resize.SetAttribute("width", "20");
+			resize.SetAttribute("height", "20");
+
+			using (MagickImage image = new MagickImage(Files.GraphicsMagickNETIconPNG))
+			{
+				new MagickScript(doc).Execute(image);
+				Assert.AreEqual(20, image.Width);
+			}
+		}
+		//===========================================================================================
+		[TestMethod, TestCategory(_Category)]
+		public void Test_Compile()
+		{
+			MagickScript script = new MagickScript(Files.VariablesScript);
+			script.Compile();
+			script.Compile();
+
+			for (int i = 1; i <= 2; i++)
+			{
+				using (MagickImage image = new MagickImage(Files.GraphicsMagickNETIconPNG))
+				{
+					script.Variables["width"] = 50 * i;
+					script.Variables["height"] = 50 * i;
+
+					script.Execute(image);
+
+					Assert.AreEqual(50 * i, image.Width);
+					Assert.AreEqual(50 * i, image.Height);
+				}
+			}
+
+			script = new MagickScript(Files.ScaleScript);
+			script.Compile();
+
+			for (int i = 0; i < 2; i++)
+			{
+				using (MagickImage image = new MagickImage(Files.ImageMagickJPG))
+				{
+					script.Execute(image);
+					TestScriptScaleResult(image);
+				}
+			}
+		}
+		//===========================================================================================
+		[TestMethod, TestCategory(_Category)]
+		public void Test_ExecuteBatch()
+		{
+			XmlDocument doc = new XmlDocument();
+			doc.LoadXml(@"<msl>
+				<read>
+					<resize width=""10"" height=""10""/>
+					<write id=""batch""/>
+				</read>
+			</msl>");
+
+			MagickScript script = new MagickScript(doc);
+
+			List<string> fileNames = new List<string>();
+			script.Write += delegate(object sender, ScriptWriteEventArgs arguments)
+			{
+				Assert.AreEqual("batch", arguments.Id);
+				Assert.IsTrue(arguments.Image.Width <= 10);
+				Assert.IsTrue(arguments.Image.Height <= 10);
+
+				lock (fileNames)
+				{
+					fileNames.Add(arguments.Image.FileName);
+				}
+			};
+
+			ExceptionAssert.Throws<ArgumentNullException>(delegate()
+			{
+				script.ExecuteBatch(null, 2);
+			});
+
+			ExceptionAssert.Throws<ArgumentException>(delegate()
+			{
+				script.ExecuteBatch(new string[] { Files.ImageMagickJPG }, 0);
+			});
+
+			var errors = script.ExecuteBatch(new string[] { Files.ImageMagickJPG, Files.Missing, Files.SnakewarePNG }, 2);
+
+			Assert.AreEqual(1, errors.Count);
+			Assert.IsInstanceOfType(errors[Files.Missing], typeof(ArgumentException));
+			Assert.AreEqual(2, fileNames.Count);
+
+			try
+			{
+				script.ExecuteBatch(EnumerateAndFail(), 2);
+				Assert.Fail("The error of the enumeration should be thrown.");
+			}
+			catch (InvalidOperationException exception)
+			{
+				Assert.IsInstanceOfType(exception.InnerException, typeof(IOException));
+			}
+		}
+		//===========================================================================================
+		[TestMethod, TestCategory(_Category)]
 		public void Test_Execute_Collection()
 		{
 			MagickScript script = new MagickScript(Files.CollectionScript);
@@ -187,6 +316,75 @@ namespace GraphicsMagick.NET.Tests
 		}
 		//===========================================================================================
 		[TestMethod, TestCategory(_Category)]
+		public void Test_Execute_Parallel()
+		{
+			XmlDocument doc = new XmlDocument();
+			doc.LoadXml(@"<msl>
+				<read>
+					<clone>
+						<resize width=""10"" height=""10""/>
+						<write id=""small""/>
+					</clone>
+					<clone>
+						<resize width=""20"" height=""20""/>
+						<write id=""medium""/>
+					</clone>
+					<write id=""large""/>
+				</read>
+			</msl>");
+
+			MagickScript script = new MagickScript(doc);
+
+			ExceptionAssert.Throws<ArgumentException>(delegate()
+			{
+				script.MaxDegreeOfParallelism = 0;
+			});
+
+			script.MaxDegreeOfParallelism = 4;
+
+			List<string> ids = new List<string>();
+			List<int> widths = new List<int>();
+			script.Write += delegate(object sender, ScriptWriteEventArgs arguments)
+			{
+				ids.Add(arguments.Id);
+				widths.Add(arguments.Image.Width);
+			};
+
+			using (MagickImage image = new MagickImage(Color.Red, 100, 100))
+			{
+				script.Execute(image);
+			}
+
+			CollectionAssert.AreEqual(new string[] { "small", "medium", "large" }, ids);
+			CollectionAssert.AreEqual(new int[] { 10, 20, 100 }, widths);
+
+			doc = new XmlDocument();
+			doc.LoadXml(@"<msl>
+				<read>
+					<clone>
+						<write id=""small""/>
+					</clone>
+				</read>
+			</msl>");
+
+			script = new MagickScript(doc);
+			script.MaxDegreeOfParallelism = 2;
+
+			using (MagickImage image = new MagickImage(Color.Red, 100, 100))
+			{
+				try
+				{
+					script.Execute(image);
+					Assert.Fail("The clone operation should fail without a Write event.");
+				}
+				catch (MagickErrorException exception)
+				{
+					Assert.IsInstanceOfType(exception.InnerException, typeof(InvalidOperationException));
+				}
+			}
+		}
+		//===========================================================================================
+		[TestMethod, TestCategory(_Category)]
 		public void Test_Execute_Scale()
 		{
 			MagickScript script = new MagickScript(Files.ScaleScript);
@@ -205,6 +403,92 @@ namespace GraphicsMagick.NET.Tests
 		}
 		//===========================================================================================
 		[TestMethod, TestCategory(_Category)]
+		public void Test_Execute_Trace()
+		{
+			MagickScript script = new MagickScript(Files.ScaleScript);
+
+			List<ScriptTraceEventArgs> events = new List<ScriptTraceEventArgs>();
+			script.Trace += delegate(object sender, ScriptTraceEventArgs arguments)
+			{
+				events.Add(arguments);
+			};
+
+			ScriptTraceSummary summary = new ScriptTraceSummary();
+			script.Trace += summary.Add;
+
+			using (MagickImage image = new MagickImage(Files.ImageMagickJPG))
+			{
+				script.Execute(image);
+				TestScriptScaleResult(image);
+			}
+
+			Assert.AreEqual(3, events.Count);
+			Assert.AreEqual("scale", events[0].Name);
+			Assert.AreEqual(123, events[0].OriginalWidth);
+			Assert.AreEqual(62, events[0].Width);
+			Assert.AreEqual(59, events[0].Height);
+			Assert.AreEqual("strip", events[1].Name);
+			Assert.AreEqual("comment", events[2].Name);
+
+			string[] lines = summary.ToString().Split(new string[] { Environment.NewLine }, StringSplitOptions.RemoveEmptyEntries);
+			Assert.AreEqual(4, lines.Length);
+			StringAssert.StartsWith(lines[1], "scale");
+		}
+		//===========================================================================================
+		[TestMethod, TestCategory(_Category)]
+		public void Test_Execute_Trace_Draw()
+		{
+			MagickScript script = new MagickScript(Files.DrawScript);
+
+			List<string> names = new List<string>();
+			script.Trace += delegate(object sender, ScriptTraceEventArgs arguments)
+			{
+				names.Add(arguments.Name);
+			};
+
+			using (MagickImage image = new MagickImage(Files.ImageMagickJPG))
+			{
+				script.Execute(image);
+			}
+
+			Assert.AreEqual(11, names.Count);
+			Assert.AreEqual("fillColor", names[0]);
+			Assert.AreEqual("circle", names[1]);
+			Assert.AreEqual("text", names[9]);
+			Assert.AreEqual("draw", names[10]);
+		}
+		//===========================================================================================
+		[TestMethod, TestCategory(_Category)]
+		public void Test_Execute_TraceInterval()
+		{
+			MagickScript script = new MagickScript(Files.ScaleScript);
+			Assert.AreEqual(1, script.TraceInterval);
+
+			ExceptionAssert.Throws<ArgumentException>(delegate()
+			{
+				script.TraceInterval = 0;
+			});
+
+			script.TraceInterval = 2;
+
+			int count = 0;
+			script.Trace += delegate(object sender, ScriptTraceEventArgs arguments)
+			{
+				count++;
+			};
+
+			for (int i = 0; i < 3; i++)
+			{
+				using (MagickImage image = new MagickImage(Files.ImageMagickJPG))
+				{
+					script.Execute(image);
+				}
+			}
+
+			Assert.AreEqual(6, count);
+		}
+		//===========================================================================================
+		[TestMethod, TestCategory(_Category)]
 		public void Test_Execute_Variables()
 		{
 			MagickScript script = new MagickScript(Files.VariablesScript);
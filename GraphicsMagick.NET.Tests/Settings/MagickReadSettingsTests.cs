@@ -13,6 +13,7 @@
 //=================================================================================================
 
 using System;
+using System.IO;
 using GraphicsMagick;
 using Microsoft.VisualStudio.TestTools.UnitTesting;
 
@@ -43,6 +44,226 @@ namespace GraphicsMagick.NET.Tests
 		}
 		//===========================================================================================
 		[TestMethod, TestCategory(_Category)]
+		public void Test_DecodedCache()
+		{
+			string directory = Path.Combine(Path.GetTempPath(), "Test_DecodedCache");
+			string fileName = Path.Combine(directory, "Snakeware.png");
+
+			try
+			{
+				MagickReadSettings settings = new MagickReadSettings();
+				settings.DecodedCachePolicy = DecodedCachePolicy.ReadWrite;
+
+				ExceptionAssert.Throws<ArgumentException>(delegate()
+				{
+					new MagickImage(Files.SnakewarePNG, settings);
+				});
+
+				settings.DecodedCacheDirectory = directory;
+
+				Directory.CreateDirectory(directory);
+				File.Copy(Files.SnakewarePNG, fileName);
+				File.SetLastWriteTimeUtc(fileName, DateTime.UtcNow.AddHours(-2));
+
+				string signature;
+				using (MagickImage image = new MagickImage(fileName, settings))
+				{
+					Assert.AreEqual(MagickFormat.Png, image.Format);
+					signature = image.Signature;
+				}
+
+				Assert.AreEqual(1, Directory.GetFiles(directory, "*.mpc").Length);
+				Assert.AreEqual(1, Directory.GetFiles(directory, "*.cache").Length);
+
+				// The contents of the file are changed but not its date, so the image can only be
+				// read from the decoded cache.
+				File.Copy(Files.RedPNG, fileName, true);
+				File.SetLastWriteTimeUtc(fileName, DateTime.UtcNow.AddHours(-2));
+
+				settings.DecodedCachePolicy = DecodedCachePolicy.ReadOnly;
+				using (MagickImage image = new MagickImage(fileName, settings))
+				{
+					Assert.AreEqual(MagickFormat.Png, image.Format);
+					Assert.AreEqual(signature, image.Signature);
+				}
+
+				File.SetLastWriteTimeUtc(fileName, DateTime.UtcNow.AddHours(1));
+				using (MagickImage image = new MagickImage(fileName, settings))
+				{
+					Assert.AreNotEqual(signature, image.Signature);
+				}
+
+				File.SetLastWriteTimeUtc(fileName, DateTime.UtcNow.AddHours(-2));
+
+				settings.DecodedCachePolicy = DecodedCachePolicy.ReadWrite;
+				using (MagickImage image = new MagickImage(fileName + "[0]", settings))
+				{
+					Assert.AreNotEqual(signature, image.Signature);
+				}
+
+				Assert.AreEqual(2, Directory.GetFiles(directory, "*.mpc").Length);
+
+				// A frame suffix should not prevent that a changed file is detected.
+				File.Copy(Files.SnakewarePNG, fileName, true);
+				File.SetLastWriteTimeUtc(fileName, DateTime.UtcNow.AddHours(1));
+
+				settings.DecodedCachePolicy = DecodedCachePolicy.ReadOnly;
+				using (MagickImage image = new MagickImage(fileName + "[0]", settings))
+				{
+					Assert.AreEqual(signature, image.Signature);
+				}
+
+				settings.Density = new MagickGeometry(300, 300);
+				using (MagickImage image = new MagickImage(fileName, settings))
+				{
+					Assert.AreEqual(300, image.Density.Width);
+				}
+
+				Assert.AreEqual(2, Directory.GetFiles(directory, "*.mpc").Length);
+			}
+			finally
+			{
+				if (Directory.Exists(directory))
+					Directory.Delete(directory, true);
+			}
+		}
+		//===========================================================================================
+		[TestMethod, TestCategory(_Category)]
+		public void Test_DecodedCache_OtherVolume()
+		{
+			string tempRoot = Path.GetPathRoot(Path.GetTempPath());
+			string directory = null;
+
+			// The test machines run Windows, a second volume is only available when the machine has
+			// another fixed drive that can be written to.
+			foreach (DriveInfo drive in DriveInfo.GetDrives())
+			{
+				if (!drive.IsReady || drive.DriveType != DriveType.Fixed)
+					continue;
+
+				if (string.Equals(drive.RootDirectory.FullName, tempRoot, StringComparison.OrdinalIgnoreCase))
+					continue;
+
+				try
+				{
+					directory = Path.Combine(drive.RootDirectory.FullName, "Test_DecodedCache_OtherVolume");
+					Directory.CreateDirectory(directory);
+					break;
+				}
+				catch (IOException)
+				{
+					directory = null;
+				}
+				catch (UnauthorizedAccessException)
+				{
+					directory = null;
+				}
+			}
+
+			if (directory == null)
+				Assert.Inconclusive("This test requires a second fixed volume that can be written to.");
+
+			string fileName = Path.Combine(Path.GetTempPath(), "Test_DecodedCache_OtherVolume.png");
+
+			try
+			{
+				File.Copy(Files.SnakewarePNG, fileName, true);
+				File.SetLastWriteTimeUtc(fileName, DateTime.UtcNow.AddHours(-2));
+
+				MagickReadSettings settings = new MagickReadSettings();
+				settings.DecodedCacheDirectory = directory;
+				settings.DecodedCachePolicy = DecodedCachePolicy.ReadWrite;
+
+				string signature;
+				using (MagickImage image = new MagickImage(fileName, settings))
+				{
+					signature = image.Signature;
+				}
+
+				Assert.AreEqual(1, Directory.GetFiles(directory, "*.mpc").Length);
+				Assert.AreEqual(1, Directory.GetFiles(directory, "*.cache").Length);
+
+				// The source file is changed without changing its date, so the image can only be read
+				// from the pair on the other volume.
+				File.Copy(Files.RedPNG, fileName, true);
+				File.SetLastWriteTimeUtc(fileName, DateTime.UtcNow.AddHours(-2));
+
+				settings.DecodedCachePolicy = DecodedCachePolicy.ReadOnly;
+				using (MagickImage image = new MagickImage(fileName, settings))
+				{
+					Assert.AreEqual(MagickFormat.Png, image.Format);
+					Assert.AreEqual(signature, image.Signature);
+				}
+			}
+			finally
+			{
+				File.Delete(fileName);
+
+				if (Directory.Exists(directory))
+					Directory.Delete(directory, true);
+			}
+		}
+		//===========================================================================================
+		[TestMethod, TestCategory(_Category)]
+		public void Test_DecodedCache_Stale()
+		{
+			string directory = Path.Combine(Path.GetTempPath(), "Test_DecodedCache_Stale");
+			string fileName = Path.Combine(directory, "Snakeware.png");
+
+			try
+			{
+				Directory.CreateDirectory(directory);
+				File.Copy(Files.SnakewarePNG, fileName);
+				File.SetLastWriteTimeUtc(fileName, DateTime.UtcNow.AddHours(-2));
+
+				MagickReadSettings settings = new MagickReadSettings();
+				settings.DecodedCacheDirectory = directory;
+				settings.DecodedCachePolicy = DecodedCachePolicy.ReadWrite;
+
+				string signature;
+				using (MagickImage image = new MagickImage(fileName, settings))
+				{
+					signature = image.Signature;
+				}
+
+				string cacheFileName = Directory.GetFiles(directory, "*.mpc")[0];
+				string pixelCacheFileName = Path.ChangeExtension(cacheFileName, ".cache");
+				DateTime cacheDate = File.GetLastWriteTimeUtc(cacheFileName);
+
+				// The new contents of the source file are newer than the pair, so the pair is stale
+				// and should not be used.
+				File.Copy(Files.RedPNG, fileName, true);
+				File.SetLastWriteTimeUtc(fileName, cacheDate.AddHours(1));
+
+				settings.DecodedCachePolicy = DecodedCachePolicy.ReadOnly;
+				using (MagickImage image = new MagickImage(fileName, settings))
+				{
+					Assert.AreNotEqual(signature, image.Signature);
+					signature = image.Signature;
+				}
+
+				Assert.AreEqual(cacheDate, File.GetLastWriteTimeUtc(cacheFileName));
+				Assert.IsTrue(File.Exists(pixelCacheFileName));
+
+				// A stale pair is replaced when the cache can be written.
+				settings.DecodedCachePolicy = DecodedCachePolicy.ReadWrite;
+				using (MagickImage image = new MagickImage(fileName, settings))
+				{
+					Assert.AreEqual(signature, image.Signature);
+				}
+
+				Assert.AreEqual(1, Directory.GetFiles(directory, "*.mpc").Length);
+				Assert.AreEqual(1, Directory.GetFiles(directory, "*.cache").Length);
+				Assert.AreNotEqual(cacheDate, File.GetLastWriteTimeUtc(cacheFileName));
+			}
+			finally
+			{
+				if (Directory.Exists(directory))
+					Directory.Delete(directory, true);
+			}
+		}
+		//===========================================================================================
+		[TestMethod, TestCategory(_Category)]
 		public void Test_Image_Read()
 		{
 			using (MagickImage image = new MagickImage())
@@ -59,6 +280,23 @@ namespace GraphicsMagick.NET.Tests
 			}
 		}
 		//===========================================================================================
+		[TestMethod, TestCategory(_Category)]
+		public void Test_ToString()
+		{
+			MagickReadSettings first = new MagickReadSettings();
+			first.Density = new MagickGeometry(150, 150);
+			first.SetDefine(MagickFormat.Jpeg, "size", "100x100");
+
+			MagickReadSettings second = new MagickReadSettings();
+			second.Density = new MagickGeometry(150, 150);
+			second.SetDefine(MagickFormat.Jpeg, "size", "100x100");
+
+			Assert.AreEqual(first.ToString(), second.ToString());
+
+			second.SetDefine(MagickFormat.Jpeg, "size", "200x200");
+			Assert.AreNotEqual(first.ToString(), second.ToString());
+		}
+		//===========================================================================================
 	}
 	//==============================================================================================
 }
@@ -0,0 +1,84 @@
+﻿//=================================================================================================
+// Copyright 2014-2015 Dirk Lemstra <https://graphicsmagick.codeplex.com/>
+//
+// Licensed under the ImageMagick License (the "License"); you may not use this file except in 
+// compliance with the License. You may obtain a copy of the License at
+//
+//   http://www.imagemagick.org/script/license.php
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the
+// License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing permissions and
+// limitations under the License.
+//=================================================================================================
+
+using System;
+using System.Collections.Generic;
+using System.Globalization;
+using System.Runtime.CompilerServices;
+using System.Security.Cryptography;
+using System.Text;
+using System.Xml.XPath;
+
+namespace GraphicsMagick.Web
+{
+	//==============================================================================================
+	internal static class CacheKeys
+	{
+		//===========================================================================================
+		private const int _MaxFileNameHashes = 4096;
+		private static readonly Dictionary<string, string> _FileNameHashes = new Dictionary<string, string>(StringComparer.OrdinalIgnoreCase);
+		private static readonly ConditionalWeakTable<IXPathNavigable, string> _ScriptHashes = new ConditionalWeakTable<IXPathNavigable, string>();
+		//===========================================================================================
+		private static string CalculateMD5(string value)
+		{
+			using (MD5 md5 = MD5.Create())
+			{
+				byte[] data = md5.ComputeHash(Encoding.Default.GetBytes(value));
+
+				StringBuilder sb = new StringBuilder();
+				for (int i = 0; i < data.Length; i++)
+				{
+					sb.Append(data[i].ToString("X2", CultureInfo.InvariantCulture));
+				}
+
+				return sb.ToString();
+			}
+		}
+		//===========================================================================================
+		private static string CalculateScriptHash(IXPathNavigable xml)
+		{
+			return CalculateMD5(xml.CreateNavigator().OuterXml);
+		}
+		//===========================================================================================
+		public static string GetFileNameHash(string fileName)
+		{
+			string hash;
+
+			lock (_FileNameHashes)
+			{
+				if (_FileNameHashes.TryGetValue(fileName, out hash))
+					return hash;
+			}
+
+			hash = CalculateMD5(fileName);
+
+			lock (_FileNameHashes)
+			{
+				if (_FileNameHashes.Count >= _MaxFileNameHashes)
+					_FileNameHashes.Clear();
+
+				_FileNameHashes[fileName] = hash;
+			}
+
+			return hash;
+		}
+		//===========================================================================================
+		public static string GetScriptHash(IXPathNavigable xml)
+		{
+			return _ScriptHashes.GetValue(xml, CalculateScriptHash);
+		}
+		//===========================================================================================
+	}
+	//==============================================================================================
+}
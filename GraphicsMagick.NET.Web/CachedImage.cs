@@ -0,0 +1,64 @@
+﻿//=================================================================================================
+// Copyright 2014-2015 Dirk Lemstra <https://graphicsmagick.codeplex.com/>
+//
+// Licensed under the ImageMagick License (the "License"); you may not use this file except in 
+// compliance with the License. You may obtain a copy of the License at
+//
+//   http://www.imagemagick.org/script/license.php
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the
+// License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing permissions and
+// limitations under the License.
+//=================================================================================================
+
+using System;
+using System.Threading;
+
+namespace GraphicsMagick.Web
+{
+	//==============================================================================================
+	internal sealed class CachedImage
+	{
+		//===========================================================================================
+		private long _TouchDate;
+		//===========================================================================================
+		public CachedImage(byte[] data, DateTime fileDate, DateTime modificationDate)
+		{
+			Data = data;
+			FileDate = fileDate;
+			ModificationDate = modificationDate;
+		}
+		//===========================================================================================
+		public byte[] Data
+		{
+			get;
+			private set;
+		}
+		//===========================================================================================
+		public DateTime FileDate
+		{
+			get;
+			private set;
+		}
+		//===========================================================================================
+		public DateTime ModificationDate
+		{
+			get;
+			private set;
+		}
+		//===========================================================================================
+		public bool Touch(TimeSpan interval)
+		{
+			long now = DateTime.UtcNow.Ticks;
+			long touchDate = Interlocked.Read(ref _TouchDate);
+
+			if (now - touchDate < interval.Ticks)
+				return false;
+
+			return Interlocked.CompareExchange(ref _TouchDate, now, touchDate) == touchDate;
+		}
+		//===========================================================================================
+	}
+	//==============================================================================================
+}
@@ -12,8 +12,12 @@
 // limitations under the License.
 //=================================================================================================
 
+using System;
+using System.Collections.Generic;
+using System.Collections.ObjectModel;
 using System.Configuration;
 using System.Diagnostics.CodeAnalysis;
+using System.Globalization;
 using System.IO;
 using System.Web.Hosting;
 
@@ -26,7 +30,28 @@ namespace GraphicsMagick.Web
 	public sealed class MagickWebSettings : ConfigurationSection
 	{
 		//===========================================================================================
-		[ConfigurationProperty("cacheDirectory", IsRequired = true)]
+		private ReadOnlyCollection<MagickFormat> _AcceptFormatList;
+		private ReadOnlyCollection<int> _WidthList;
+		//===========================================================================================
+		[ConfigurationProperty("acceptFormats", DefaultValue = "")]
+		private string _AcceptFormats
+		{
+			get
+			{
+				return (string)this["acceptFormats"];
+			}
+		}
+		//===========================================================================================
+		[ConfigurationProperty("asyncRendering", DefaultValue = false)]
+		private bool _AsyncRendering
+		{
+			get
+			{
+				return (bool)this["asyncRendering"];
+			}
+		}
+		//===========================================================================================
+		[ConfigurationProperty("cacheDirectory", DefaultValue = "")]
 		private string _CacheDirectory
 		{
 			get
@@ -39,6 +64,33 @@ namespace GraphicsMagick.Web
 			}
 		}
 		//===========================================================================================
+		[ConfigurationProperty("cacheMaxAge", DefaultValue = "00:00:00")]
+		private TimeSpan _CacheMaxAge
+		{
+			get
+			{
+				return (TimeSpan)this["cacheMaxAge"];
+			}
+		}
+		//===========================================================================================
+		[ConfigurationProperty("cacheMaxSize", DefaultValue = 0L)]
+		private long _CacheMaxSize
+		{
+			get
+			{
+				return (long)this["cacheMaxSize"];
+			}
+		}
+		//===========================================================================================
+		[ConfigurationProperty("cacheSweepInterval", DefaultValue = "00:05:00")]
+		private TimeSpan _CacheSweepInterval
+		{
+			get
+			{
+				return (TimeSpan)this["cacheSweepInterval"];
+			}
+		}
+		//===========================================================================================
 		[SuppressMessage("Microsoft.Naming", "CA2204:Literals should be spelled correctly", MessageId = "magick")]
 		private static MagickWebSettings _Instance
 		{
@@ -52,6 +104,78 @@ namespace GraphicsMagick.Web
 			}
 		}
 		//===========================================================================================
+		[ConfigurationProperty("maxConcurrentRenders", DefaultValue = 0)]
+		private int _MaxConcurrentRenders
+		{
+			get
+			{
+				return (int)this["maxConcurrentRenders"];
+			}
+		}
+		//===========================================================================================
+		[ConfigurationProperty("maxRenderQueueLength", DefaultValue = 100)]
+		private int _MaxRenderQueueLength
+		{
+			get
+			{
+				return (int)this["maxRenderQueueLength"];
+			}
+		}
+		//===========================================================================================
+		[ConfigurationProperty("memoryCacheSize", DefaultValue = 0L)]
+		private long _MemoryCacheSize
+		{
+			get
+			{
+				return (long)this["memoryCacheSize"];
+			}
+		}
+		//===========================================================================================
+		[ConfigurationProperty("renderMemoryBudget", DefaultValue = 0L)]
+		private long _RenderMemoryBudget
+		{
+			get
+			{
+				return (long)this["renderMemoryBudget"];
+			}
+		}
+		//===========================================================================================
+		[ConfigurationProperty("renderOnChange", DefaultValue = false)]
+		private bool _RenderOnChange
+		{
+			get
+			{
+				return (bool)this["renderOnChange"];
+			}
+		}
+		//===========================================================================================
+		[ConfigurationProperty("renderQueueTimeout", DefaultValue = "00:00:30")]
+		private TimeSpan _RenderQueueTimeout
+		{
+			get
+			{
+				return (TimeSpan)this["renderQueueTimeout"];
+			}
+		}
+		//===========================================================================================
+		[ConfigurationProperty("renderSaturationAction", DefaultValue = RenderSaturationAction.ServiceUnavailable)]
+		private RenderSaturationAction _RenderSaturationAction
+		{
+			get
+			{
+				return (RenderSaturationAction)this["renderSaturationAction"];
+			}
+		}
+		//===========================================================================================
+		[ConfigurationProperty("renderThreads", DefaultValue = 0)]
+		private int _RenderThreads
+		{
+			get
+			{
+				return (int)this["renderThreads"];
+			}
+		}
+		//===========================================================================================
 		[ConfigurationProperty("showVersion", DefaultValue = true)]
 		private bool _ShowVersion
 		{
@@ -61,6 +185,15 @@ namespace GraphicsMagick.Web
 			}
 		}
 		//===========================================================================================
+		[ConfigurationProperty("sourceCacheSize", DefaultValue = 0L)]
+		private long _SourceCacheSize
+		{
+			get
+			{
+				return (long)this["sourceCacheSize"];
+			}
+		}
+		//===========================================================================================
 		[ConfigurationProperty("urlResolvers")]
 		private UrlResolverSettingsCollection _UrlResolvers
 		{
@@ -69,6 +202,59 @@ namespace GraphicsMagick.Web
 				return (UrlResolverSettingsCollection)this["urlResolvers"];
 			}
 		}
+		//===========================================================================================
+		[ConfigurationProperty("watchSourceFiles", DefaultValue = false)]
+		private bool _WatchSourceFiles
+		{
+			get
+			{
+				return (bool)this["watchSourceFiles"];
+			}
+		}
+		//===========================================================================================
+		[ConfigurationProperty("widths", DefaultValue = "")]
+		private string _Widths
+		{
+			get
+			{
+				return (string)this["widths"];
+			}
+		}
+		//===========================================================================================
+		private static ReadOnlyCollection<MagickFormat> ParseFormats(string value)
+		{
+			List<MagickFormat> formats = new List<MagickFormat>();
+
+			foreach (string format in value.Split(new char[] { ',' }, StringSplitOptions.RemoveEmptyEntries))
+			{
+				try
+				{
+					formats.Add((MagickFormat)Enum.Parse(typeof(MagickFormat), format.Trim(), true));
+				}
+				catch (ArgumentException)
+				{
+					throw new ConfigurationErrorsException("Invalid format specified: " + format);
+				}
+			}
+
+			return formats.AsReadOnly();
+		}
+		//===========================================================================================
+		private static ReadOnlyCollection<int> ParseWidths(string value)
+		{
+			List<int> widths = new List<int>();
+
+			foreach (string width in value.Split(new char[] { ',' }, StringSplitOptions.RemoveEmptyEntries))
+			{
+				int result;
+				if (!int.TryParse(width.Trim(), NumberStyles.None, CultureInfo.InvariantCulture, out result) || result == 0)
+					throw new ConfigurationErrorsException("Invalid width specified: " + width);
+
+				widths.Add(result);
+			}
+
+			return widths.AsReadOnly();
+		}
 		///==========================================================================================
 		/// <summary>
 		/// Called after deserialization.
@@ -77,7 +263,13 @@ namespace GraphicsMagick.Web
 		{
 			base.PostDeserialize();
 
+			_AcceptFormatList = ParseFormats(_AcceptFormats);
+			_WidthList = ParseWidths(_Widths);
+
 			string directory = _CacheDirectory;
+			if (string.IsNullOrEmpty(directory))
+				return;
+
 			if (directory[0] == '~')
 				directory = Path.GetFullPath(HostingEnvironment.MapPath("~") + directory.Substring(1));
 
@@ -91,7 +283,33 @@ namespace GraphicsMagick.Web
 		}
 		///==========================================================================================
 		/// <summary>
-		/// Returns the directory that contains scripted images.
+		/// Returns the formats that are used instead of the format of the url resolver when the
+		/// Accept header of the request prefers their mime type. The format with the highest quality
+		/// value is used, the order of the formats decides between formats with the same quality.
+		/// </summary>
+		public static ReadOnlyCollection<MagickFormat> AcceptFormats
+		{
+			get
+			{
+				return _Instance._AcceptFormatList;
+			}
+		}
+		///==========================================================================================
+		/// <summary>
+		/// Returns true if the scripted images should be created asynchronously on a dedicated
+		/// set of threads instead of on the thread of the request.
+		/// </summary>
+		public static bool AsyncRendering
+		{
+			get
+			{
+				return _Instance._AsyncRendering;
+			}
+		}
+		///==========================================================================================
+		/// <summary>
+		/// Returns the directory that contains scripted images. Scripted images are not written to
+		/// disk when no directory has been specified.
 		/// </summary>
 		public static string CacheDirectory
 		{
@@ -102,6 +320,138 @@ namespace GraphicsMagick.Web
 		}
 		///==========================================================================================
 		/// <summary>
+		/// Returns the maximum age of a file in the cache directory. Older files are removed by
+		/// the background sweep and a value of 00:00:00 keeps the files forever.
+		/// </summary>
+		public static TimeSpan CacheMaxAge
+		{
+			get
+			{
+				return _Instance._CacheMaxAge;
+			}
+		}
+		///==========================================================================================
+		/// <summary>
+		/// Returns the maximum number of bytes of the files in the cache directory. The least
+		/// recently used files are removed first and a value of 0 disables the limit.
+		/// </summary>
+		public static long CacheMaxSize
+		{
+			get
+			{
+				return _Instance._CacheMaxSize;
+			}
+		}
+		///==========================================================================================
+		/// <summary>
+		/// Returns the interval of the background sweep that removes files from the cache directory.
+		/// </summary>
+		public static TimeSpan CacheSweepInterval
+		{
+			get
+			{
+				return _Instance._CacheSweepInterval;
+			}
+		}
+		///==========================================================================================
+		/// <summary>
+		/// Returns the maximum number of images that are rendered at the same time. A value of 0
+		/// disables the limit.
+		/// </summary>
+		public static int MaxConcurrentRenders
+		{
+			get
+			{
+				return _Instance._MaxConcurrentRenders;
+			}
+		}
+		///==========================================================================================
+		/// <summary>
+		/// Returns the maximum number of requests that wait for a render when the concurrency limit
+		/// or the memory budget has been reached, or when all the render threads are busy.
+		/// </summary>
+		public static int MaxRenderQueueLength
+		{
+			get
+			{
+				return _Instance._MaxRenderQueueLength;
+			}
+		}
+		///==========================================================================================
+		/// <summary>
+		/// Returns the maximum number of bytes of scripted images that are kept in memory. The
+		/// least recently used images are removed first and a value of 0 disables the memory cache.
+		/// </summary>
+		public static long MemoryCacheSize
+		{
+			get
+			{
+				return _Instance._MemoryCacheSize;
+			}
+		}
+		///==========================================================================================
+		/// <summary>
+		/// Returns the maximum number of bytes of pixel memory that is used by the images that are
+		/// rendered at the same time, estimated from the size of the source images. A value of 0
+		/// disables the budget.
+		/// </summary>
+		public static long RenderMemoryBudget
+		{
+			get
+			{
+				return _Instance._RenderMemoryBudget;
+			}
+		}
+		///==========================================================================================
+		/// <summary>
+		/// Returns true if the most requested images of a source file should be rendered again in
+		/// the background when the file changes. This requires WatchSourceFiles to be enabled.
+		/// </summary>
+		public static bool RenderOnChange
+		{
+			get
+			{
+				return _Instance._RenderOnChange;
+			}
+		}
+		///==========================================================================================
+		/// <summary>
+		/// Returns the maximum time a request waits for a render, or for another request that
+		/// renders the same image.
+		/// </summary>
+		public static TimeSpan RenderQueueTimeout
+		{
+			get
+			{
+				return _Instance._RenderQueueTimeout;
+			}
+		}
+		///==========================================================================================
+		/// <summary>
+		/// Returns what should be sent when a request could not render an image because the queue
+		/// was full or the request waited too long.
+		/// </summary>
+		public static RenderSaturationAction RenderSaturationAction
+		{
+			get
+			{
+				return _Instance._RenderSaturationAction;
+			}
+		}
+		///==========================================================================================
+		/// <summary>
+		/// Returns the number of threads that are used to create scripted images when asynchronous
+		/// rendering is enabled. A value of 0 will use the number of processors.
+		/// </summary>
+		public static int RenderThreads
+		{
+			get
+			{
+				return _Instance._RenderThreads;
+			}
+		}
+		///==========================================================================================
+		/// <summary>
 		/// Returns true if the version can be shown in the http headers.
 		/// </summary>
 		public static bool ShowVersion
@@ -111,6 +461,19 @@ namespace GraphicsMagick.Web
 				return _Instance._ShowVersion;
 			}
 		}
+		///==========================================================================================
+		/// <summary>
+		/// Returns the maximum number of bytes of pixel memory of decoded source images that are kept
+		/// in memory, scripts receive a clone of the decoded image instead of decoding the file again.
+		/// A value of 0 disables the source cache.
+		/// </summary>
+		public static long SourceCacheSize
+		{
+			get
+			{
+				return _Instance._SourceCacheSize;
+			}
+		}
 		///========================================================================================== 
 		/// <summary>
 		/// Returns the url resolvers.
@@ -122,6 +485,31 @@ namespace GraphicsMagick.Web
 				return _Instance._UrlResolvers;
 			}
 		}
+		///==========================================================================================
+		/// <summary>
+		/// Returns true if the source files should be watched for changes. The last write time of a
+		/// source file and of its cache file is then kept in memory instead of being read on every
+		/// request.
+		/// </summary>
+		public static bool WatchSourceFiles
+		{
+			get
+			{
+				return _Instance._WatchSourceFiles;
+			}
+		}
+		///==========================================================================================
+		/// <summary>
+		/// Returns the widths that can be requested with the width query string parameter. All the
+		/// widths are created from the same scripted image when one of them is rendered.
+		/// </summary>
+		public static ReadOnlyCollection<int> Widths
+		{
+			get
+			{
+				return _Instance._WidthList;
+			}
+		}
 		//===========================================================================================
 	}
 	//==============================================================================================
@@ -0,0 +1,36 @@
+﻿//=================================================================================================
+// Copyright 2014-2015 Dirk Lemstra <https://graphicsmagick.codeplex.com/>
+//
+// Licensed under the ImageMagick License (the "License"); you may not use this file except in 
+// compliance with the License. You may obtain a copy of the License at
+//
+//   http://www.imagemagick.org/script/license.php
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the
+// License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing permissions and
+// limitations under the License.
+//=================================================================================================
+
+namespace GraphicsMagick.Web
+{
+	///=============================================================================================
+	/// <summary>
+	/// Specifies what should be sent to the response when an image cannot be rendered because
+	/// the render queue is full or the request waited too long.
+	/// </summary>
+	public enum RenderSaturationAction
+	{
+		///==========================================================================================
+		/// <summary>
+		/// Send the status code 503 (Service Unavailable).
+		/// </summary>
+		ServiceUnavailable,
+		///==========================================================================================
+		/// <summary>
+		/// Send the original file.
+		/// </summary>
+		Original
+	}
+	//==============================================================================================
+}
@@ -13,6 +13,7 @@
 //=================================================================================================
 
 using System;
+using System.Collections.Generic;
 using System.Configuration;
 using System.Diagnostics.CodeAnalysis;
 using System.Linq.Expressions;
@@ -29,6 +30,63 @@ namespace GraphicsMagick.Web
 		//===========================================================================================
 		private delegate IUrlResolver IUrlResolverConstructor();
 		private IUrlResolverConstructor _Constructor;
+		private HashSet<string> _Extensions;
+		private const int _MaxResolvedUrls = 4096;
+		private readonly Dictionary<Uri, ResolvedUrl> _ResolvedUrls = new Dictionary<Uri, ResolvedUrl>();
+		//===========================================================================================
+		[ConfigurationProperty("cacheResults", DefaultValue = false)]
+		private bool _CacheResults
+		{
+			get
+			{
+				return (bool)this["cacheResults"];
+			}
+		}
+		//===========================================================================================
+		[ConfigurationProperty("extensions", DefaultValue = "")]
+		private string _ExtensionNames
+		{
+			get
+			{
+				return (string)this["extensions"];
+			}
+		}
+		//===========================================================================================
+		[ConfigurationProperty("path", DefaultValue = "")]
+		private string _Path
+		{
+			get
+			{
+				return (string)this["path"];
+			}
+		}
+		//===========================================================================================
+		private void AddResolvedUrl(Uri url, ResolvedUrl resolvedUrl)
+		{
+			lock (_ResolvedUrls)
+			{
+				if (_ResolvedUrls.Count >= _MaxResolvedUrls)
+					_ResolvedUrls.Clear();
+
+				_ResolvedUrls[url] = resolvedUrl;
+			}
+		}
+		//===========================================================================================
+		private bool CanResolve(Uri url)
+		{
+			if (!string.IsNullOrEmpty(_Path) && !url.AbsolutePath.StartsWith(_Path, StringComparison.OrdinalIgnoreCase))
+				return false;
+
+			if (_Extensions == null)
+				return true;
+
+			string path = url.AbsolutePath;
+			int index = path.LastIndexOf('.');
+			if (index == -1 || index < path.LastIndexOf('/'))
+				return false;
+
+			return _Extensions.Contains(path.Substring(index + 1));
+		}
 		//===========================================================================================
 		[ConfigurationProperty("type", IsRequired = true)]
 		internal string TypeName
@@ -43,6 +101,34 @@ namespace GraphicsMagick.Web
 		{
 			return _Constructor();
 		}
+		//===========================================================================================
+		internal IUrlResolver Resolve(Uri url)
+		{
+			if (!CanResolve(url))
+				return null;
+
+			ResolvedUrl resolvedUrl;
+
+			if (_CacheResults)
+			{
+				lock (_ResolvedUrls)
+				{
+					if (_ResolvedUrls.TryGetValue(url, out resolvedUrl))
+						return resolvedUrl;
+				}
+			}
+
+			IUrlResolver urlResolver = CreateInstance();
+			if (!urlResolver.Resolve(url))
+				urlResolver = null;
+
+			if (!_CacheResults)
+				return urlResolver;
+
+			resolvedUrl = urlResolver == null ? null : new ResolvedUrl(url, urlResolver);
+			AddResolvedUrl(url, resolvedUrl);
+			return resolvedUrl;
+		}
 		///==========================================================================================
 		/// <summary>
 		/// Called after deserialization.
@@ -60,6 +146,15 @@ namespace GraphicsMagick.Web
 			ConstructorInfo ctor = UrlResolverType.GetConstructor(new Type[] { });
 			NewExpression newExp = Expression.New(ctor);
 			_Constructor = (IUrlResolverConstructor)Expression.Lambda(typeof(IUrlResolverConstructor), newExp).Compile();
+
+			if (!string.IsNullOrEmpty(_ExtensionNames))
+			{
+				_Extensions = new HashSet<string>(StringComparer.OrdinalIgnoreCase);
+				foreach (string extension in _ExtensionNames.Split(','))
+				{
+					_Extensions.Add(extension.Trim().TrimStart('.'));
+				}
+			}
 		}
 		///==========================================================================================
 		/// <summary>
@@ -0,0 +1,233 @@
+﻿//=================================================================================================
+// Copyright 2014-2015 Dirk Lemstra <https://graphicsmagick.codeplex.com/>
+//
+// Licensed under the ImageMagick License (the "License"); you may not use this file except in 
+// compliance with the License. You may obtain a copy of the License at
+//
+//   http://www.imagemagick.org/script/license.php
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the
+// License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing permissions and
+// limitations under the License.
+//=================================================================================================
+
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Threading;
+
+namespace GraphicsMagick.Web
+{
+	//==============================================================================================
+	internal static class DiskCache
+	{
+		//===========================================================================================
+		private static readonly Dictionary<string, DiskCacheEntry> _Entries = new Dictionary<string, DiskCacheEntry>(StringComparer.OrdinalIgnoreCase);
+		private static bool _IsIndexed;
+		private static int _IsSweeping;
+		private static readonly TimeSpan _MaxAge = MagickWebSettings.CacheMaxAge;
+		private static readonly long _MaxSize = MagickWebSettings.CacheMaxSize;
+		private static long _Size;
+		private static readonly TimeSpan _TemporaryFileAge = TimeSpan.FromHours(1);
+		private static readonly Timer _Timer = CreateTimer();
+		//===========================================================================================
+		private static Timer CreateTimer()
+		{
+			if (string.IsNullOrEmpty(MagickWebSettings.CacheDirectory))
+				return null;
+
+			if (_MaxAge <= TimeSpan.Zero && _MaxSize <= 0)
+				return null;
+
+			return new Timer(Sweep, null, TimeSpan.Zero, MagickWebSettings.CacheSweepInterval);
+		}
+		//===========================================================================================
+		private static void Delete(string fileName, DiskCacheEntry entry)
+		{
+			ReaderWriterLockSlim fileLock = FileLocks.Get(fileName);
+			fileLock.EnterWriteLock();
+
+			try
+			{
+				File.Delete(fileName);
+			}
+			catch (IOException)
+			{
+				return;
+			}
+			catch (UnauthorizedAccessException)
+			{
+				return;
+			}
+			finally
+			{
+				fileLock.ExitWriteLock();
+			}
+
+			// The date of the file is also cached by the watcher when the cache directory is watched.
+			SourceFileWatcher.Invalidate(fileName);
+
+			lock (_Entries)
+			{
+				DiskCacheEntry current;
+				if (!_Entries.TryGetValue(fileName, out current) || current != entry)
+					return;
+
+				_Entries.Remove(fileName);
+				_Size -= entry.Size;
+			}
+		}
+		//===========================================================================================
+		private static void Index()
+		{
+			try
+			{
+				foreach (string fileName in Directory.EnumerateFiles(MagickWebSettings.CacheDirectory, "*", SearchOption.AllDirectories))
+				{
+					// Temporary files are moved to the cache file when they are complete and are not
+					// part of the cache. Only the ones that were left behind by a crash are removed.
+					if (IsTemporaryFile(fileName))
+					{
+						if (File.GetCreationTimeUtc(fileName) < DateTime.UtcNow - _TemporaryFileAge)
+							Delete(fileName, null);
+
+						continue;
+					}
+
+					if (!IsCacheFile(fileName))
+					{
+						Delete(fileName, null);
+						continue;
+					}
+
+					FileInfo file = new FileInfo(fileName);
+					if (!file.Exists)
+						continue;
+
+					lock (_Entries)
+					{
+						if (_Entries.ContainsKey(fileName))
+							continue;
+
+						_Entries.Add(fileName, new DiskCacheEntry(file.Length, file.LastWriteTimeUtc));
+						_Size += file.Length;
+					}
+				}
+			}
+			catch (IOException)
+			{
+			}
+			catch (UnauthorizedAccessException)
+			{
+			}
+		}
+		//===========================================================================================
+		private static bool IsCacheFile(string fileName)
+		{
+			// The files are stored in a directory that is named after the first two characters of the
+			// file name hash. Files outside those directories were created before the cache was
+			// sharded and can no longer be found by a request.
+			string[] parts = fileName.Substring(MagickWebSettings.CacheDirectory.Length).Split('\\');
+			if (parts.Length != 3 || parts[1].Length != 2)
+				return false;
+
+			return parts[2].StartsWith(parts[1], StringComparison.OrdinalIgnoreCase);
+		}
+		//===========================================================================================
+		private static bool IsTemporaryFile(string fileName)
+		{
+			return fileName.EndsWith(".tmp", StringComparison.OrdinalIgnoreCase);
+		}
+		//===========================================================================================
+		private static void Sweep(object state)
+		{
+			if (Interlocked.Exchange(ref _IsSweeping, 1) == 1)
+				return;
+
+			try
+			{
+				if (!_IsIndexed)
+				{
+					Index();
+					_IsIndexed = true;
+				}
+
+				List<KeyValuePair<string, DiskCacheEntry>> entries;
+				lock (_Entries)
+				{
+					entries = new List<KeyValuePair<string, DiskCacheEntry>>(_Entries);
+				}
+
+				if (_MaxAge > TimeSpan.Zero)
+				{
+					DateTime minimumDate = DateTime.UtcNow - _MaxAge;
+					foreach (KeyValuePair<string, DiskCacheEntry> entry in entries)
+					{
+						if (entry.Value.CreationDate < minimumDate)
+							Delete(entry.Key, entry.Value);
+					}
+				}
+
+				if (_MaxSize > 0)
+				{
+					entries.Sort((a, b) => a.Value.LastAccessDate.CompareTo(b.Value.LastAccessDate));
+
+					// Remove a bit more than needed to avoid a sweep after every new file.
+					long maxSize = _MaxSize / 10 * 9;
+					foreach (KeyValuePair<string, DiskCacheEntry> entry in entries)
+					{
+						lock (_Entries)
+						{
+							if (_Size <= maxSize)
+								break;
+						}
+
+						Delete(entry.Key, entry.Value);
+					}
+				}
+			}
+			finally
+			{
+				Interlocked.Exchange(ref _IsSweeping, 0);
+			}
+		}
+		//===========================================================================================
+		public static void Add(string fileName, long size)
+		{
+			if (_Timer == null)
+				return;
+
+			bool sweep;
+
+			lock (_Entries)
+			{
+				DiskCacheEntry entry;
+				if (_Entries.TryGetValue(fileName, out entry))
+					_Size -= entry.Size;
+
+				_Entries[fileName] = new DiskCacheEntry(size, DateTime.UtcNow);
+				_Size += size;
+				sweep = _MaxSize > 0 && _Size > _MaxSize;
+			}
+
+			if (sweep)
+				ThreadPool.QueueUserWorkItem(Sweep);
+		}
+		//===========================================================================================
+		public static void Touch(string fileName)
+		{
+			if (_Timer == null)
+				return;
+
+			lock (_Entries)
+			{
+				DiskCacheEntry entry;
+				if (_Entries.TryGetValue(fileName, out entry))
+					entry.LastAccessDate = DateTime.UtcNow;
+			}
+		}
+		//===========================================================================================
+	}
+	//==============================================================================================
+}
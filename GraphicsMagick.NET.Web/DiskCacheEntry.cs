@@ -0,0 +1,50 @@
+﻿//=================================================================================================
+// Copyright 2014-2015 Dirk Lemstra <https://graphicsmagick.codeplex.com/>
+//
+// Licensed under the ImageMagick License (the "License"); you may not use this file except in 
+// compliance with the License. You may obtain a copy of the License at
+//
+//   http://www.imagemagick.org/script/license.php
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the
+// License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing permissions and
+// limitations under the License.
+//=================================================================================================
+
+using System;
+
+namespace GraphicsMagick.Web
+{
+	//==============================================================================================
+	internal sealed class DiskCacheEntry
+	{
+		//===========================================================================================
+		public DiskCacheEntry(long size, DateTime creationDate)
+		{
+			Size = size;
+			CreationDate = creationDate;
+			LastAccessDate = creationDate;
+		}
+		//===========================================================================================
+		public DateTime CreationDate
+		{
+			get;
+			private set;
+		}
+		//===========================================================================================
+		public DateTime LastAccessDate
+		{
+			get;
+			set;
+		}
+		//===========================================================================================
+		public long Size
+		{
+			get;
+			private set;
+		}
+		//===========================================================================================
+	}
+	//==============================================================================================
+}
@@ -0,0 +1,45 @@
+﻿//=================================================================================================
+// Copyright 2014-2015 Dirk Lemstra <https://graphicsmagick.codeplex.com/>
+//
+// Licensed under the ImageMagick License (the "License"); you may not use this file except in 
+// compliance with the License. You may obtain a copy of the License at
+//
+//   http://www.imagemagick.org/script/license.php
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the
+// License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing permissions and
+// limitations under the License.
+//=================================================================================================
+
+using System;
+using System.Threading;
+
+namespace GraphicsMagick.Web
+{
+	//==============================================================================================
+	internal static class FileLocks
+	{
+		//===========================================================================================
+		private static readonly ReaderWriterLockSlim[] _Locks = CreateLocks(64);
+		//===========================================================================================
+		private static ReaderWriterLockSlim[] CreateLocks(int count)
+		{
+			ReaderWriterLockSlim[] locks = new ReaderWriterLockSlim[count];
+			for (int i = 0; i < count; i++)
+			{
+				locks[i] = new ReaderWriterLockSlim();
+			}
+
+			return locks;
+		}
+		//===========================================================================================
+		public static ReaderWriterLockSlim Get(string fileName)
+		{
+			int hashCode = StringComparer.OrdinalIgnoreCase.GetHashCode(fileName);
+			return _Locks[(hashCode & int.MaxValue) % _Locks.Length];
+		}
+		//===========================================================================================
+	}
+	//==============================================================================================
+}
@@ -0,0 +1,237 @@
+﻿//=================================================================================================
+// Copyright 2014-2015 Dirk Lemstra <https://graphicsmagick.codeplex.com/>
+//
+// Licensed under the ImageMagick License (the "License"); you may not use this file except in 
+// compliance with the License. You may obtain a copy of the License at
+//
+//   http://www.imagemagick.org/script/license.php
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the
+// License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing permissions and
+// limitations under the License.
+//=================================================================================================
+
+using System;
+using System.Diagnostics.CodeAnalysis;
+using System.Threading;
+using System.Threading.Tasks;
+using System.Web;
+
+namespace GraphicsMagick.Web
+{
+	///=============================================================================================
+	/// <summary>
+	/// IHttpAsyncHandler that can be used to send a scripted image to the response. The image is
+	/// created on a dedicated set of threads, cached images are written on the thread of the
+	/// request. No thread is blocked while a request waits for a render or for the image of
+	/// another request. The handler does not require the session state.
+	/// </summary>
+	public sealed class MagickScriptAsyncHandler : IHttpAsyncHandler
+	{
+		//===========================================================================================
+		private MagickScriptHandler _Handler;
+		//===========================================================================================
+		private void BeginRender(HttpContext context, TaskCompletionSource<object> completionSource, AsyncCallback cb)
+		{
+			bool isOwner;
+			PendingImage pendingImage = _Handler.GetPendingImage(out isOwner);
+
+			if (!isOwner)
+			{
+				// The response is written by a continuation of the image of the other request.
+				pendingImage.ContinueWith(delegate(bool isCompleted)
+				{
+					Execute(context, completionSource, cb, delegate()
+					{
+						if (!_Handler.WritePendingImage(context, pendingImage.GetImage(isCompleted)))
+							BeginRender(context, completionSource, cb);
+						else
+							Complete(completionSource, cb, null);
+					});
+				});
+				return;
+			}
+
+			// The admission is applied before the render is queued, so the limits of the renders also
+			// apply to the requests that wait for a render thread. The render is queued by the callback
+			// when a render has finished and the admission allows it.
+			_Handler.BeginEnterRender(pendingImage, delegate(bool isAdmitted)
+			{
+				Execute(context, completionSource, cb, delegate()
+				{
+					if (isAdmitted)
+					{
+						QueueRender(context, completionSource, cb, pendingImage);
+						return;
+					}
+
+					_Handler.WriteRejected(context);
+					Complete(completionSource, cb, null);
+				});
+			});
+		}
+		//===========================================================================================
+		[SuppressMessage("Microsoft.Design", "CA1031:DoNotCatchGeneralExceptionTypes")]
+		private static void Complete(TaskCompletionSource<object> completionSource, AsyncCallback cb, Exception exception)
+		{
+			if (exception != null)
+				completionSource.SetException(exception);
+			else
+				completionSource.SetResult(null);
+
+			if (cb == null)
+				return;
+
+			try
+			{
+				cb(completionSource.Task);
+			}
+			catch (Exception)
+			{
+				// An exception of the callback cannot be reported to the request anymore and should not
+				// stop the thread that completed the request.
+			}
+		}
+		//===========================================================================================
+		[SuppressMessage("Microsoft.Design", "CA1031:DoNotCatchGeneralExceptionTypes")]
+		private void Execute(HttpContext context, TaskCompletionSource<object> completionSource, AsyncCallback cb, Action action)
+		{
+			try
+			{
+				try
+				{
+					action();
+				}
+				catch (RenderRejectedException)
+				{
+					_Handler.WriteRejected(context);
+					Complete(completionSource, cb, null);
+				}
+			}
+			catch (Exception exception)
+			{
+				Complete(completionSource, cb, exception);
+			}
+		}
+		private void QueueRender(HttpContext context, TaskCompletionSource<object> completionSource, AsyncCallback cb, PendingImage pendingImage)
+		{
+			bool added = RenderQueue.TryAdd(delegate()
+			{
+				CachedImage image = null;
+				Exception error = null;
+
+				try
+				{
+					image = _Handler.RenderImage(pendingImage);
+				}
+				catch (Exception exception)
+				{
+					error = exception;
+				}
+
+				// Only the image is created on the render thread, the response is written on the
+				// thread pool so a slow client cannot block the other renders.
+				ThreadPool.QueueUserWorkItem(delegate(object state)
+				{
+					Execute(context, completionSource, cb, delegate()
+					{
+						if (error == null && image == null)
+						{
+							// The cache file was removed before it could be read.
+							BeginRender(context, completionSource, cb);
+						}
+						else if (error == null)
+						{
+							_Handler.WriteRenderedImage(context, image);
+							Complete(completionSource, cb, null);
+						}
+						else if (error is RenderRejectedException)
+						{
+							_Handler.WriteRejected(context);
+							Complete(completionSource, cb, null);
+						}
+						else
+						{
+							Complete(completionSource, cb, error);
+						}
+					});
+				});
+			});
+
+			if (added)
+				return;
+
+			_Handler.RejectRender(pendingImage);
+			_Handler.WriteRejected(context);
+			Complete(completionSource, cb, null);
+		}
+		//===========================================================================================
+		internal MagickScriptAsyncHandler(MagickScriptHandler handler)
+		{
+			_Handler = handler;
+		}
+		///==========================================================================================
+		/// <summary>
+		/// Gets a value indicating whether another request can use the IHttpHandler instance.
+		/// </summary>
+		public bool IsReusable
+		{
+			get
+			{
+				return false;
+			}
+		}
+		///==========================================================================================
+		/// <summary>
+		/// Initiates an asynchronous call to the HTTP handler.
+		/// </summary>
+		/// <param name="context">An HttpContext object that provides references to intrinsic server
+		/// objects (for example, Request, Response, Session, and Server) used to service HTTP
+		/// requests.</param>
+		/// <param name="cb">The AsyncCallback to call when the asynchronous method call is complete.</param>
+		/// <param name="extraData">Any extra data needed to process the request.</param>
+		public IAsyncResult BeginProcessRequest(HttpContext context, AsyncCallback cb, object extraData)
+		{
+			TaskCompletionSource<object> completionSource = new TaskCompletionSource<object>(extraData);
+
+			Execute(context, completionSource, cb, delegate()
+			{
+				if (_Handler.WriteCachedResponse(context))
+					Complete(completionSource, cb, null);
+				else
+					BeginRender(context, completionSource, cb);
+			});
+
+			return completionSource.Task;
+		}
+		///==========================================================================================
+		/// <summary>
+		/// Provides an asynchronous process End method when the process ends.
+		/// </summary>
+		/// <param name="result">An IAsyncResult that contains information about the status of the
+		/// process.</param>
+		public void EndProcessRequest(IAsyncResult result)
+		{
+			Task task = result as Task;
+			if (task == null)
+				throw new ArgumentException("Invalid result specified.", "result");
+
+			if (task.IsFaulted)
+				throw new HttpException(500, task.Exception.InnerException.Message, task.Exception.InnerException);
+		}
+		///==========================================================================================
+		/// <summary>
+		/// Processes the request synchronously.
+		/// </summary>
+		/// <param name="context">An HttpContext object that provides references to the intrinsic
+		/// server objects (for example, Request, Response, Session, and Server) used to service
+		/// HTTP requests.</param>
+		public void ProcessRequest(HttpContext context)
+		{
+			_Handler.ProcessRequest(context);
+		}
+		//===========================================================================================
+	}
+	//==============================================================================================
+}
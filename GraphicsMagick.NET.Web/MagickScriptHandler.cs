@@ -13,11 +13,11 @@
 //=================================================================================================
 
 using System;
+using System.Collections.Generic;
+using System.Diagnostics.CodeAnalysis;
 using System.Globalization;
 using System.IO;
 using System.Reflection;
-using System.Security.Cryptography;
-using System.Text;
 using System.Threading;
 using System.Web;
 using System.Web.SessionState;
@@ -32,54 +32,169 @@ namespace GraphicsMagick.Web
 	public class MagickScriptHandler : IHttpHandler, IRequiresSessionState
 	{
 		//===========================================================================================
+		private string _CacheFileName;
+		private string _ETag;
+		private DateTime _FileDate;
+		private MagickFormat _Format;
 		private MagickFormatInfo _FormatInfo;
-		private static readonly ReaderWriterLockSlim _Lock = new ReaderWriterLockSlim();
+		private static readonly Dictionary<MagickFormat, MagickFormatInfo> _FormatInfos = new Dictionary<MagickFormat, MagickFormatInfo>();
+		private static readonly MemoryImageCache _MemoryCache = new MemoryImageCache(MagickWebSettings.MemoryCacheSize);
+		private static readonly Dictionary<MagickFormat, string> _MimeTypes = CreateMimeTypes();
+		private static readonly Dictionary<string, PendingImage> _PendingImages = new Dictionary<string, PendingImage>(StringComparer.OrdinalIgnoreCase);
+		private long _ReservedMemory = -1;
+		private IXPathNavigable _Script;
+		private MagickImage _ScriptedImage;
+		private string _ScriptHash;
+		private static readonly SourceImageCache _SourceCache = new SourceImageCache(MagickWebSettings.SourceCacheSize);
+		private static readonly TimeSpan _TouchInterval = TimeSpan.FromMinutes(1);
 		private IUrlResolver _UrlResolver;
+		private static readonly bool _UseDiskCache = !string.IsNullOrEmpty(MagickWebSettings.CacheDirectory);
 		private static readonly string _Version = GetVersion();
+		private int _Width;
 		//===========================================================================================
-		private static string CalculateMD5(string value)
+		private static void AddVersionHeader(HttpContext context)
 		{
-			using (MD5 md5 = MD5.Create())
-			{
-				byte[] data = md5.ComputeHash(Encoding.Default.GetBytes(value));
+			if (!string.IsNullOrEmpty(_Version))
+				context.Response.AddHeader("X-Magick", _Version);
+		}
+		//===========================================================================================
+		private static bool CanUseCache(string cacheFileName, DateTime fileDate)
+		{
+			if (!_UseDiskCache)
+				return false;
 
-				StringBuilder sb = new StringBuilder();
-				for (int i = 0; i < data.Length; i++)
-				{
-					sb.Append(data[i].ToString("X2", CultureInfo.InvariantCulture));
-				}
+			// The date of the cache file comes from the same map as the date of the source file, so
+			// the file system is only checked again after the cache file has been changed.
+			DateTime cacheDate = SourceFileWatcher.GetLastWriteTime(cacheFileName);
+			return cacheDate != DateTime.MinValue && fileDate <= cacheDate;
+		}
+		//===========================================================================================
+		private CachedImage CreateCachedImage(MagickImage image, int width, DateTime fileDate)
+		{
+			if (width <= 0 || width >= image.Width)
+			{
+				image.Format = _Format;
+				return new CachedImage(image.ToByteArray(), fileDate, DateTime.Now);
+			}
 
-				return sb.ToString();
+			using (MagickImage resizedImage = image.Clone())
+			{
+				resizedImage.Resize(width, 0);
+				resizedImage.Format = _Format;
+				return new CachedImage(resizedImage.ToByteArray(), fileDate, DateTime.Now);
 			}
 		}
 		//===========================================================================================
-		private bool CanUseCache(string cacheFileName)
+		private static Dictionary<MagickFormat, string> CreateMimeTypes()
 		{
-			_Lock.EnterReadLock();
+			Dictionary<MagickFormat, string> mimeTypes = new Dictionary<MagickFormat, string>();
+			mimeTypes[MagickFormat.Bmp] = "image/bmp";
+			mimeTypes[MagickFormat.Bmp2] = "image/bmp";
+			mimeTypes[MagickFormat.Bmp3] = "image/bmp";
+			mimeTypes[MagickFormat.Cur] = "image/x-icon";
+			mimeTypes[MagickFormat.Eps] = "application/postscript";
+			mimeTypes[MagickFormat.Gif] = "image/gif";
+			mimeTypes[MagickFormat.Gif87] = "image/gif";
+			mimeTypes[MagickFormat.Ico] = "image/x-icon";
+			mimeTypes[MagickFormat.Icon] = "image/x-icon";
+			mimeTypes[MagickFormat.Jp2] = "image/jp2";
+			mimeTypes[MagickFormat.Jpeg] = "image/jpeg";
+			mimeTypes[MagickFormat.Jpg] = "image/jpeg";
+			mimeTypes[MagickFormat.Pdf] = "application/pdf";
+			mimeTypes[MagickFormat.Png] = "image/png";
+			mimeTypes[MagickFormat.Png8] = "image/png";
+			mimeTypes[MagickFormat.Png24] = "image/png";
+			mimeTypes[MagickFormat.Png32] = "image/png";
+			mimeTypes[MagickFormat.Png48] = "image/png";
+			mimeTypes[MagickFormat.Png64] = "image/png";
+			mimeTypes[MagickFormat.Ps] = "application/postscript";
+			mimeTypes[MagickFormat.Ptif] = "image/tiff";
+			mimeTypes[MagickFormat.Svg] = "image/svg+xml";
+			mimeTypes[MagickFormat.Svgz] = "image/svg+xml";
+			mimeTypes[MagickFormat.Tif] = "image/tiff";
+			mimeTypes[MagickFormat.Tiff] = "image/tiff";
+			mimeTypes[MagickFormat.Wbmp] = "image/vnd.wap.wbmp";
+			mimeTypes[MagickFormat.WebP] = "image/webp";
+			mimeTypes[MagickFormat.Xpm] = "image/x-xpixmap";
+			return mimeTypes;
+		}
+		//===========================================================================================
+		private MagickImage ExecuteScript()
+		{
+			MagickScript script = new MagickScript(_Script);
+			script.Read += OnScriptRead;
 
-			try
-			{
-				if (!File.Exists(cacheFileName))
-					return false;
+			return script.Execute();
+		}
+		private static int GetAcceptQuality(List<KeyValuePair<string, double>> mediaTypes, string mimeType, out double quality)
+		{
+			string range = mimeType.Substring(0, mimeType.IndexOf('/') + 1) + "*";
+			int specificity = -1;
+			quality = 0;
 
-				DateTime fileDate = File.GetLastWriteTime(_UrlResolver.FileName);
-				DateTime cacheDate = File.GetLastWriteTime(cacheFileName);
-				return fileDate <= cacheDate;
-			}
-			finally
+			// The quality of the most specific media range that matches the mime type is used, so
+			// image/webp;q=0 excludes the format even when */* is also accepted.
+			foreach (KeyValuePair<string, double> mediaType in mediaTypes)
 			{
-				_Lock.ExitReadLock();
+				int mediaTypeSpecificity;
+				if (string.Equals(mediaType.Key, mimeType, StringComparison.OrdinalIgnoreCase))
+					mediaTypeSpecificity = 2;
+				else if (string.Equals(mediaType.Key, range, StringComparison.OrdinalIgnoreCase))
+					mediaTypeSpecificity = 1;
+				else if (mediaType.Key == "*/*")
+					mediaTypeSpecificity = 0;
+				else
+					continue;
+
+				if (mediaTypeSpecificity <= specificity)
+					continue;
+
+				specificity = mediaTypeSpecificity;
+				quality = mediaType.Value;
 			}
+
+			return specificity;
 		}
 		//===========================================================================================
-		private string GetCacheFileName(IXPathNavigable xml)
+		private string GetCacheFileName(string scriptHash, int width)
 		{
-			string cacheDirectory = MagickWebSettings.CacheDirectory + CalculateMD5(xml.CreateNavigator().OuterXml) + "\\";
+			string fileNameHash = CacheKeys.GetFileNameHash(_UrlResolver.FileName);
+			string cacheDirectory = MagickWebSettings.CacheDirectory + scriptHash + "\\" + fileNameHash.Substring(0, 2) + "\\";
 
-			if (!Directory.Exists(cacheDirectory))
-				Directory.CreateDirectory(cacheDirectory);
+			if (width > 0)
+				return cacheDirectory + fileNameHash + "." + width.ToString(CultureInfo.InvariantCulture) + "." + _Format;
 
-			return cacheDirectory + CalculateMD5(_UrlResolver.FileName) + "." + _UrlResolver.Format;
+			return cacheDirectory + fileNameHash + "." + _Format;
+		}
+		//===========================================================================================
+		private string GetETag(string scriptHash, DateTime fileDate)
+		{
+			return string.Format(CultureInfo.InvariantCulture, "\"{0}-{1:X}-{2}-{3}\"", scriptHash, fileDate.ToFileTimeUtc(), _Width, _Format);
+		}
+		//===========================================================================================
+		private static MagickFormatInfo GetFormatInformation(MagickFormat format)
+		{
+			MagickFormatInfo formatInfo;
+
+			lock (_FormatInfos)
+			{
+				if (!_FormatInfos.TryGetValue(format, out formatInfo))
+				{
+					formatInfo = GraphicsMagickNET.GetFormatInformation(format);
+					_FormatInfos.Add(format, formatInfo);
+				}
+			}
+
+			return formatInfo;
+		}
+		//===========================================================================================
+		private static string GetMimeType(MagickFormat format)
+		{
+			string mimeType;
+			if (!_MimeTypes.TryGetValue(format, out mimeType))
+				return null;
+
+			return mimeType;
 		}
 		//===========================================================================================
 		private static string GetVersion()
@@ -91,12 +206,251 @@ namespace GraphicsMagick.Web
 			return ((AssemblyFileVersionAttribute)version).Version;
 		}
 		//===========================================================================================
+		private static int GetWidth(HttpContext context)
+		{
+			if (MagickWebSettings.Widths.Count == 0)
+				return 0;
+
+			int width;
+			if (!int.TryParse(context.Request.QueryString["width"], NumberStyles.None, CultureInfo.InvariantCulture, out width))
+				return 0;
+
+			// Only the configured widths are allowed to limit the number of images in the cache.
+			return MagickWebSettings.Widths.Contains(width) ? width : 0;
+		}
+		//===========================================================================================
+		private static bool IsMatch(string noneMatch, string eTag)
+		{
+			foreach (string value in noneMatch.Split(','))
+			{
+				string tag = value.Trim();
+				if (tag == "*" || tag == eTag || tag == "W/" + eTag)
+					return true;
+			}
+
+			return false;
+		}
+		//===========================================================================================
+		private MagickFormat NegotiateFormat(HttpContext context)
+		{
+			if (MagickWebSettings.AcceptFormats.Count == 0)
+				return _UrlResolver.Format;
+
+			context.Response.AppendHeader("Vary", "Accept");
+
+			string accept = context.Request.Headers["Accept"];
+			if (string.IsNullOrEmpty(accept))
+				return _UrlResolver.Format;
+
+			List<KeyValuePair<string, double>> mediaTypes = ParseAccept(accept);
+
+			MagickFormat result = _UrlResolver.Format;
+			double resultQuality = 0;
+			int resultSpecificity = -1;
+
+			// The original format is kept when it is accepted as well as the other formats, so a
+			// client that only sends image/* or */* does not receive a format it might not support.
+			string resultMimeType = GetMimeType(result);
+			if (resultMimeType != null)
+				resultSpecificity = GetAcceptQuality(mediaTypes, resultMimeType, out resultQuality);
+
+			// The format with the highest quality is used, an exact match wins from a media range
+			// with the same quality and the order of the accept formats decides the rest.
+			foreach (MagickFormat format in MagickWebSettings.AcceptFormats)
+			{
+				string mimeType = GetMimeType(format);
+				if (mimeType == null)
+					continue;
+
+				double quality;
+				int specificity = GetAcceptQuality(mediaTypes, mimeType, out quality);
+				if (specificity == -1 || quality <= 0)
+					continue;
+
+				if (quality < resultQuality || (quality == resultQuality && specificity <= resultSpecificity))
+					continue;
+
+				MagickFormatInfo formatInfo = GetFormatInformation(format);
+				if (formatInfo == null || !formatInfo.IsWritable)
+					continue;
+
+				result = format;
+				resultQuality = quality;
+				resultSpecificity = specificity;
+			}
+
+			return result;
+		}
+		//===========================================================================================
 		private void OnScriptRead(object sender, ScriptReadEventArgs arguments)
 		{
-			arguments.Image = new MagickImage(_UrlResolver.FileName, arguments.Settings);
+			arguments.Image = _SourceCache.Read(_UrlResolver.FileName, _FileDate, arguments.Settings);
+		}
+		private static List<KeyValuePair<string, double>> ParseAccept(string accept)
+		{
+			List<KeyValuePair<string, double>> mediaTypes = new List<KeyValuePair<string, double>>();
+
+			foreach (string value in accept.Split(','))
+			{
+				string[] parts = value.Split(';');
+
+				string mediaType = parts[0].Trim();
+				if (mediaType.Length == 0)
+					continue;
+
+				double quality = 1;
+				for (int i = 1; i < parts.Length; i++)
+				{
+					string parameter = parts[i].Trim();
+					if (!parameter.StartsWith("q=", StringComparison.OrdinalIgnoreCase))
+						continue;
+
+					// A media type with an invalid quality is handled as not acceptable.
+					if (!double.TryParse(parameter.Substring(2), NumberStyles.AllowDecimalPoint, CultureInfo.InvariantCulture, out quality) || quality > 1)
+						quality = 0;
+
+					break;
+				}
+
+				mediaTypes.Add(new KeyValuePair<string, double>(mediaType, quality));
+			}
+
+			return mediaTypes;
+		}
+		//===========================================================================================
+		private bool PrepareScriptedFile(HttpContext context)
+		{
+			_Script = _UrlResolver.Script;
+			if (_Script == null)
+				return false;
+
+			_Format = NegotiateFormat(context);
+			_Width = GetWidth(context);
+
+			_ScriptHash = CacheKeys.GetScriptHash(_Script);
+			_CacheFileName = GetCacheFileName(_ScriptHash, _Width);
+			_FileDate = SourceFileWatcher.GetLastWriteTime(_UrlResolver.FileName);
+			_ETag = GetETag(_ScriptHash, _FileDate);
+
+			SourceFileWatcher.AddHit(_UrlResolver.FileName, _CacheFileName, this);
+			return true;
 		}
 		//===========================================================================================
-		private static bool Write304(HttpContext content, DateTime fileDate)
+		private void QueueWidths()
+		{
+			if (!_UseDiskCache && !_MemoryCache.IsEnabled)
+				return;
+
+			List<Tuple<int, string, PendingImage>> widths = new List<Tuple<int, string, PendingImage>>();
+
+			foreach (int width in MagickWebSettings.Widths)
+			{
+				if (width == _Width)
+					continue;
+
+				string cacheFileName = GetCacheFileName(_ScriptHash, width);
+				if (_MemoryCache.Get(cacheFileName, _FileDate) != null || CanUseCache(cacheFileName, _FileDate))
+					continue;
+
+				lock (_PendingImages)
+				{
+					if (_PendingImages.ContainsKey(cacheFileName))
+						continue;
+
+					PendingImage pendingImage = new PendingImage();
+					_PendingImages.Add(cacheFileName, pendingImage);
+					widths.Add(new Tuple<int, string, PendingImage>(width, cacheFileName, pendingImage));
+				}
+			}
+
+			if (widths.Count == 0)
+				return;
+
+			// The other widths are created from the same scripted image in the background, so the
+			// source file is only decoded once for all the widths. The scripted image and its memory
+			// reservation are released when all the widths have been created.
+			MagickImage image = _ScriptedImage;
+			long memory = _ReservedMemory;
+			_ScriptedImage = null;
+			_ReservedMemory = -1;
+
+			ThreadPool.QueueUserWorkItem(delegate(object state)
+			{
+				WriteWidthsToCache(image, memory, widths);
+			});
+		}
+		//===========================================================================================
+		private static CachedImage ReadFromCache(string cacheFileName, DateTime fileDate)
+		{
+			ReaderWriterLockSlim fileLock = FileLocks.Get(cacheFileName);
+			fileLock.EnterReadLock();
+
+			try
+			{
+				DiskCache.Touch(cacheFileName);
+				return new CachedImage(File.ReadAllBytes(cacheFileName), fileDate, File.GetLastWriteTime(cacheFileName));
+			}
+			catch (IOException)
+			{
+				// The file was removed by the sweep of the disk cache or by another process after it
+				// was checked. The date is checked again so the image will be rendered.
+				SourceFileWatcher.Invalidate(cacheFileName);
+				return null;
+			}
+			finally
+			{
+				fileLock.ExitReadLock();
+			}
+		}
+		//===========================================================================================
+		private void ReleaseRender()
+		{
+			if (_ScriptedImage != null)
+			{
+				_ScriptedImage.Dispose();
+				_ScriptedImage = null;
+			}
+
+			if (_ReservedMemory != -1)
+			{
+				RenderAdmission.Exit(_ReservedMemory);
+				_ReservedMemory = -1;
+			}
+
+			lock (_PendingImages)
+			{
+				_PendingImages.Remove(_CacheFileName);
+			}
+		}
+		//===========================================================================================
+		private void Render()
+		{
+			_Script = _UrlResolver.Script;
+			_ScriptHash = CacheKeys.GetScriptHash(_Script);
+			_CacheFileName = GetCacheFileName(_ScriptHash, _Width);
+			_FileDate = SourceFileWatcher.GetLastWriteTime(_UrlResolver.FileName);
+
+			if (_MemoryCache.Get(_CacheFileName, _FileDate) != null || CanUseCache(_CacheFileName, _FileDate))
+				return;
+
+			PendingImage pendingImage;
+
+			lock (_PendingImages)
+			{
+				if (_PendingImages.ContainsKey(_CacheFileName))
+					return;
+
+				_PendingImages.Add(_CacheFileName, pendingImage = new PendingImage());
+			}
+
+			EnterRender(pendingImage);
+
+			CachedImage image = RenderImage(pendingImage);
+			if (image != null)
+				WriteRenderedImage(null, image);
+		}
+		//===========================================================================================
+		private static bool Write304(HttpContext content, DateTime fileDate, string eTag)
 		{
 			DateTime modificationDate = new DateTime(fileDate.Year, fileDate.Month, fileDate.Day, fileDate.Hour, fileDate.Minute, fileDate.Second);
 			if (modificationDate > DateTime.Now)
@@ -105,15 +459,25 @@ namespace GraphicsMagick.Web
 			modificationDate = modificationDate.ToUniversalTime();
 
 			string modifiedSince = null;
+			string noneMatch = null;
 			try
 			{
 				content.Response.Cache.SetLastModified(modificationDate);
 				modifiedSince = content.Request.Headers["If-Modified-Since"];
+
+				if (eTag != null)
+				{
+					content.Response.AddHeader("ETag", eTag);
+					noneMatch = content.Request.Headers["If-None-Match"];
+				}
 			}
 			catch (ThreadAbortException)
 			{
 			}
 
+			if (!string.IsNullOrEmpty(noneMatch))
+				return IsMatch(noneMatch, eTag) && WriteNotModified(content);
+
 			if (string.IsNullOrEmpty(modifiedSince))
 				return false;
 
@@ -129,96 +493,406 @@ namespace GraphicsMagick.Web
 			bool success = DateTime.TryParseExact(since, "r", CultureInfo.InvariantCulture, DateTimeStyles.None, out modifiedDate);
 
 			if (success && modifiedDate == modificationDate)
+				return WriteNotModified(content);
+
+			return false;
+		}
+		//===========================================================================================
+		private bool WriteCachedImage(HttpContext context)
+		{
+			CachedImage image = _MemoryCache.Get(_CacheFileName, _FileDate);
+			if (image != null)
 			{
-				try
-				{
-					content.Response.StatusCode = 304;
-					return true;
-				}
-				catch (ThreadAbortException)
-				{
-				}
+				// The file in the disk cache is touched once in a while to prevent that the sweep
+				// removes the images that are served from the memory cache.
+				if (_UseDiskCache && image.Touch(_TouchInterval))
+					DiskCache.Touch(_CacheFileName);
+
+				WriteImage(context, image);
+				return true;
 			}
 
-			return false;
+			if (!CanUseCache(_CacheFileName, _FileDate))
+				return false;
+
+			if (!_MemoryCache.IsEnabled)
+			{
+				DiskCache.Touch(_CacheFileName);
+				WriteFile(context, _CacheFileName, _ETag, _Format);
+				return true;
+			}
+
+			image = ReadFromCache(_CacheFileName, _FileDate);
+			if (image == null)
+				return false;
+
+			_MemoryCache.Add(_CacheFileName, image);
+			WriteImage(context, image);
+			return true;
+		}
+		//===========================================================================================
+		private static void WriteContentType(HttpContext context, MagickFormat format)
+		{
+			string mimeType = GetMimeType(format);
+			if (mimeType != null)
+				context.Response.ContentType = mimeType;
 		}
 		//===========================================================================================
 		private void WriteFile(HttpContext context)
 		{
-			WriteFile(context, _UrlResolver.FileName);
+			WriteFile(context, _UrlResolver.FileName, null, _UrlResolver.Format);
 		}
 		//===========================================================================================
-		private static void WriteFile(HttpContext context, string fileName)
+		private static void WriteFile(HttpContext context, string fileName, string eTag, MagickFormat format)
 		{
-			_Lock.EnterReadLock();
+			ReaderWriterLockSlim fileLock = FileLocks.Get(fileName);
+			fileLock.EnterReadLock();
 
 			try
 			{
-				if (Write304(context, File.GetLastWriteTime(fileName)))
+				if (Write304(context, File.GetLastWriteTime(fileName), eTag))
 					return;
 
+				WriteContentType(context, format);
 				context.Response.TransmitFile(fileName);
 			}
 			finally
 			{
-				_Lock.ExitReadLock();
+				fileLock.ExitReadLock();
 			}
 		}
 		//===========================================================================================
-		private bool WriteScriptedFile(HttpContext context)
+		private void WriteImage(HttpContext context, CachedImage image)
 		{
-			IXPathNavigable xml = _UrlResolver.Script;
-			if (xml == null)
-				return false;
+			if (Write304(context, image.ModificationDate, _ETag))
+				return;
 
-			string cacheFileName = GetCacheFileName(xml);
-			if (CanUseCache(cacheFileName))
+			WriteContentType(context, _Format);
+			context.Response.OutputStream.Write(image.Data, 0, image.Data.Length);
+		}
+		//===========================================================================================
+		private static bool WriteNotModified(HttpContext content)
+		{
+			try
 			{
-				WriteFile(context, cacheFileName);
+				content.Response.StatusCode = 304;
 				return true;
 			}
+			catch (ThreadAbortException)
+			{
+			}
 
-			MagickScript script = new MagickScript(xml);
-			script.Read += OnScriptRead;
+			return false;
+		}
+		//===========================================================================================
+		private bool WriteScriptedFile(HttpContext context)
+		{
+			if (!PrepareScriptedFile(context))
+				return false;
+
+			if (!WriteCachedImage(context))
+				WriteScriptedImage(context);
 
-			using (MagickImage image = script.Execute())
+			return true;
+		}
+		//===========================================================================================
+		private void WriteScriptedImage(HttpContext context)
+		{
+			while (true)
 			{
-				image.Format = _UrlResolver.Format;
-				WriteToCache(image, cacheFileName);
-				WriteFile(context, cacheFileName);
+				bool isOwner;
+				PendingImage pendingImage = GetPendingImage(out isOwner);
+
+				if (isOwner)
+				{
+					EnterRender(pendingImage);
+
+					CachedImage image = RenderImage(pendingImage);
+					if (image == null)
+						continue;
+
+					WriteRenderedImage(context, image);
+					return;
+				}
+
+				if (WritePendingImage(context, pendingImage.Wait()))
+					return;
 			}
+		}
+		//===========================================================================================
+		private static void WriteServiceUnavailable(HttpContext context)
+		{
+			int retryAfter = Math.Max(1, (int)Math.Ceiling(MagickWebSettings.RenderQueueTimeout.TotalSeconds));
 
-			return true;
+			context.Response.StatusCode = 503;
+			context.Response.AddHeader("Retry-After", retryAfter.ToString(CultureInfo.InvariantCulture));
 		}
 		//===========================================================================================
-		private static void WriteToCache(MagickImage image, string cacheFileName)
+		private static void WriteToCache(CachedImage image, string cacheFileName)
 		{
-			string tempFile = Path.GetTempFileName();
+			string tempFile = cacheFileName + "." + Guid.NewGuid().ToString("N") + ".tmp";
 
 			try
 			{
-				image.Write(tempFile);
+				string cacheDirectory = Path.GetDirectoryName(cacheFileName);
+				if (!Directory.Exists(cacheDirectory))
+					Directory.CreateDirectory(cacheDirectory);
 
-				_Lock.EnterWriteLock();
+				File.WriteAllBytes(tempFile, image.Data);
+				File.SetLastWriteTime(tempFile, image.ModificationDate);
 
-				if (File.Exists(cacheFileName))
-					File.Delete(cacheFileName);
+				ReaderWriterLockSlim fileLock = FileLocks.Get(cacheFileName);
+				fileLock.EnterWriteLock();
 
-				File.Move(tempFile, cacheFileName);
+				try
+				{
+					if (File.Exists(cacheFileName))
+						File.Delete(cacheFileName);
+
+					File.Move(tempFile, cacheFileName);
+					DiskCache.Add(cacheFileName, image.Data.Length);
+				}
+				finally
+				{
+					fileLock.ExitWriteLock();
+				}
+			}
+			catch (IOException)
+			{
+			}
+			catch (UnauthorizedAccessException)
+			{
 			}
 			finally
 			{
-				_Lock.ExitWriteLock();
-
 				if (File.Exists(tempFile))
 					File.Delete(tempFile);
 			}
 		}
 		//===========================================================================================
+		[SuppressMessage("Microsoft.Design", "CA1031:DoNotCatchGeneralExceptionTypes")]
+		private void WriteWidthsToCache(MagickImage image, long memory, List<Tuple<int, string, PendingImage>> widths)
+		{
+			try
+			{
+				foreach (Tuple<int, string, PendingImage> width in widths)
+				{
+					try
+					{
+						CachedImage widthImage = CreateCachedImage(image, width.Item1, _FileDate);
+						_MemoryCache.Add(width.Item2, widthImage);
+						width.Item3.Complete(widthImage, null);
+
+						if (_UseDiskCache)
+							WriteToCache(widthImage, width.Item2);
+					}
+					catch (Exception)
+					{
+						// The requests that wait for this width will create the image themselves.
+						width.Item3.Complete(null, null);
+					}
+					finally
+					{
+						lock (_PendingImages)
+						{
+							_PendingImages.Remove(width.Item2);
+						}
+					}
+				}
+			}
+			finally
+			{
+				image.Dispose();
+
+				if (memory != -1)
+					RenderAdmission.Exit(memory);
+			}
+		}
+		//===========================================================================================
 		internal MagickScriptHandler(IUrlResolver urlResolver)
 		{
 			_UrlResolver = urlResolver;
 		}
+		//===========================================================================================
+		internal Action CreateRender()
+		{
+			MagickScriptHandler handler = new MagickScriptHandler(new ResolvedUrl(null, _UrlResolver));
+			handler._Format = _Format;
+			handler._Width = _Width;
+
+			return handler.Render;
+		}
+		internal void BeginEnterRender(PendingImage pendingImage, Action<bool> callback)
+		{
+			if (_ReservedMemory != -1 || CanUseCache(_CacheFileName, _FileDate))
+			{
+				callback(true);
+				return;
+			}
+
+			long estimatedMemory;
+
+			try
+			{
+				estimatedMemory = RenderAdmission.EstimateMemory(_UrlResolver.FileName, _FileDate);
+			}
+			catch (Exception exception)
+			{
+				pendingImage.Complete(null, exception);
+				ReleaseRender();
+				throw;
+			}
+
+			RenderAdmission.BeginEnter(estimatedMemory, delegate(bool isAdmitted)
+			{
+				if (isAdmitted)
+				{
+					_ReservedMemory = estimatedMemory;
+				}
+				else
+				{
+					pendingImage.Complete(null, new RenderRejectedException());
+					ReleaseRender();
+				}
+
+				callback(isAdmitted);
+			});
+		}
+		//===========================================================================================
+		internal void EnterRender(PendingImage pendingImage)
+		{
+			if (_ReservedMemory != -1 || CanUseCache(_CacheFileName, _FileDate))
+				return;
+
+			try
+			{
+				long estimatedMemory = RenderAdmission.EstimateMemory(_UrlResolver.FileName, _FileDate);
+				RenderAdmission.Enter(estimatedMemory);
+				_ReservedMemory = estimatedMemory;
+			}
+			catch (Exception exception)
+			{
+				pendingImage.Complete(null, exception);
+				ReleaseRender();
+				throw;
+			}
+		}
+		//===========================================================================================
+		internal PendingImage GetPendingImage(out bool isOwner)
+		{
+			PendingImage pendingImage;
+
+			lock (_PendingImages)
+			{
+				isOwner = !_PendingImages.TryGetValue(_CacheFileName, out pendingImage);
+				if (isOwner)
+					_PendingImages.Add(_CacheFileName, pendingImage = new PendingImage());
+			}
+
+			return pendingImage;
+		}
+		//===========================================================================================
+		internal void RejectRender(PendingImage pendingImage)
+		{
+			MagickWebPerformanceCounters.AddRejectedRender();
+
+			pendingImage.Complete(null, new RenderRejectedException());
+			ReleaseRender();
+		}
+		//===========================================================================================
+		internal CachedImage RenderImage(PendingImage pendingImage)
+		{
+			CachedImage image;
+
+			try
+			{
+				if (_ReservedMemory == -1)
+				{
+					image = ReadFromCache(_CacheFileName, _FileDate);
+					if (image == null)
+					{
+						// The requests that wait for the image will start again and render it.
+						pendingImage.Complete(null, null);
+						ReleaseRender();
+						return null;
+					}
+				}
+				else
+				{
+					_ScriptedImage = ExecuteScript();
+					RenderAdmission.UpdateEstimate(_UrlResolver.FileName, _FileDate, _ScriptedImage);
+
+					image = CreateCachedImage(_ScriptedImage, _Width, _FileDate);
+				}
+			}
+			catch (Exception exception)
+			{
+				pendingImage.Complete(null, exception);
+				ReleaseRender();
+				throw;
+			}
+
+			_MemoryCache.Add(_CacheFileName, image);
+			pendingImage.Complete(image, null);
+
+			return image;
+		}
+		//===========================================================================================
+		internal bool WriteCachedResponse(HttpContext context)
+		{
+			AddVersionHeader(context);
+
+			if (!PrepareScriptedFile(context))
+			{
+				WriteFile(context);
+				return true;
+			}
+
+			return WriteCachedImage(context);
+		}
+		//===========================================================================================
+		internal bool WritePendingImage(HttpContext context, CachedImage image)
+		{
+			if (image == null || image.FileDate != _FileDate)
+				return false;
+
+			WriteImage(context, image);
+			return true;
+		}
+		//===========================================================================================
+		internal void WriteRejected(HttpContext context)
+		{
+			if (MagickWebSettings.RenderSaturationAction == RenderSaturationAction.Original)
+				WriteFile(context);
+			else
+				WriteServiceUnavailable(context);
+		}
+		//===========================================================================================
+		internal void WriteRenderedImage(HttpContext context, CachedImage image)
+		{
+			try
+			{
+				if (context != null)
+					WriteImage(context, image);
+
+				if (_ScriptedImage == null)
+					return;
+
+				// The image is written to the cache after it has been sent to the client, the
+				// pending image stays registered until then so no other request renders it again.
+				if (context != null)
+					context.Response.Flush();
+
+				if (_UseDiskCache)
+					WriteToCache(image, _CacheFileName);
+
+				QueueWidths();
+			}
+			finally
+			{
+				ReleaseRender();
+			}
+		}
 		///==========================================================================================
 		/// <summary>
 		/// Gets a value indicating whether another request can use the IHttpHandler instance.
@@ -242,12 +916,18 @@ namespace GraphicsMagick.Web
 		{
 			if (context == null)
 				return;
-			
-			if (!string.IsNullOrEmpty(_Version))
-				context.Response.AddHeader("X-Magick", _Version);
 
-			if (!WriteScriptedFile(context))
-				WriteFile(context);
+			AddVersionHeader(context);
+
+			try
+			{
+				if (!WriteScriptedFile(context))
+					WriteFile(context);
+			}
+			catch (RenderRejectedException)
+			{
+				WriteRejected(context);
+			}
 		}
 		///==========================================================================================
 		/// <summary>
@@ -260,10 +940,10 @@ namespace GraphicsMagick.Web
 				if (string.IsNullOrEmpty(_UrlResolver.FileName))
 					return false;
 
-				if (!File.Exists(_UrlResolver.FileName))
+				if (!SourceFileWatcher.Exists(_UrlResolver.FileName))
 					return false;
 
-				_FormatInfo = GraphicsMagickNET.GetFormatInformation(_UrlResolver.Format);
+				_FormatInfo = GetFormatInformation(_UrlResolver.Format);
 
 				if (_FormatInfo == null)
 					return false;
@@ -13,7 +13,6 @@
 //=================================================================================================
 
 using System;
-using System.Collections.Generic;
 using System.Configuration;
 using System.Web;
 
@@ -25,25 +24,15 @@ namespace GraphicsMagick.Web
 	/// </summary>
 	public sealed class MagickScriptModule : IHttpModule
 	{
-		//===========================================================================================
-		private static IEnumerable<IUrlResolver> _ScriptUrlResolvers
-		{
-			get
-			{
-				foreach (UrlResolverSettings settings in MagickWebSettings.UrlResolvers)
-				{
-					yield return settings.CreateInstance();
-				}
-			}
-		}
 		//===========================================================================================
 		private static IHttpHandler HandleRequest(HttpContext context)
 		{
 			Uri url = (Uri)context.Items["MagickScriptModule.Url"];
 
-			foreach (IUrlResolver scriptUrlResolver in _ScriptUrlResolvers)
+			foreach (UrlResolverSettings settings in MagickWebSettings.UrlResolvers)
 			{
-				if (scriptUrlResolver.Resolve(url))
+				IUrlResolver scriptUrlResolver = settings.Resolve(url);
+				if (scriptUrlResolver != null)
 					return CreateHttpHandler(scriptUrlResolver);
 			}
 
@@ -53,7 +42,13 @@ namespace GraphicsMagick.Web
 		private static IHttpHandler CreateHttpHandler(IUrlResolver urlResolver)
 		{
 			MagickScriptHandler scriptHandler = new MagickScriptHandler(urlResolver);
-			return scriptHandler.IsValid ? scriptHandler : null;
+			if (!scriptHandler.IsValid)
+				return null;
+
+			if (MagickWebSettings.AsyncRendering)
+				return new MagickScriptAsyncHandler(scriptHandler);
+
+			return scriptHandler;
 		}
 		//===========================================================================================
 		private void OnBeginRequest(object sender, EventArgs arguments)
@@ -0,0 +1,124 @@
+﻿//=================================================================================================
+// Copyright 2014-2015 Dirk Lemstra <https://graphicsmagick.codeplex.com/>
+//
+// Licensed under the ImageMagick License (the "License"); you may not use this file except in 
+// compliance with the License. You may obtain a copy of the License at
+//
+//   http://www.imagemagick.org/script/license.php
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the
+// License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing permissions and
+// limitations under the License.
+//=================================================================================================
+
+using System;
+using System.Diagnostics;
+using System.Security;
+
+namespace GraphicsMagick.Web
+{
+	///=============================================================================================
+	/// <summary>
+	/// Class that contains the performance counters of the render queue of Magick.NET.Web. The
+	/// counters are only updated when the category has been installed.
+	/// </summary>
+	public static class MagickWebPerformanceCounters
+	{
+		//===========================================================================================
+		private const string _ActiveRenders = "Active renders";
+		private const string _CategoryName = "GraphicsMagick.NET.Web";
+		private const string _QueueLength = "Render queue length";
+		private const string _RejectedRenders = "Rejected renders";
+		private const string _WaitTime = "Average render wait time";
+		private const string _WaitTimeBase = "Average render wait time base";
+		private static readonly PerformanceCounter[] _Counters = CreateCounters();
+		//===========================================================================================
+		private static PerformanceCounter[] CreateCounters()
+		{
+			try
+			{
+				if (!PerformanceCounterCategory.Exists(_CategoryName))
+					return null;
+
+				return new PerformanceCounter[]
+				{
+					new PerformanceCounter(_CategoryName, _ActiveRenders, false),
+					new PerformanceCounter(_CategoryName, _QueueLength, false),
+					new PerformanceCounter(_CategoryName, _RejectedRenders, false),
+					new PerformanceCounter(_CategoryName, _WaitTime, false),
+					new PerformanceCounter(_CategoryName, _WaitTimeBase, false)
+				};
+			}
+			catch (InvalidOperationException)
+			{
+				return null;
+			}
+			catch (UnauthorizedAccessException)
+			{
+				return null;
+			}
+			catch (SecurityException)
+			{
+				return null;
+			}
+		}
+		//===========================================================================================
+		internal static void AddRejectedRender()
+		{
+			if (_Counters != null)
+				_Counters[2].Increment();
+		}
+		//===========================================================================================
+		internal static void AddWaitTime(long ticks)
+		{
+			if (_Counters == null)
+				return;
+
+			_Counters[3].IncrementBy(ticks);
+			_Counters[4].Increment();
+		}
+		//===========================================================================================
+		internal static void SetActiveRenders(int value)
+		{
+			if (_Counters != null)
+				_Counters[0].RawValue = value;
+		}
+		//===========================================================================================
+		internal static void SetQueueLength(int value)
+		{
+			if (_Counters != null)
+				_Counters[1].RawValue = value;
+		}
+		///==========================================================================================
+		/// <summary>
+		/// Creates the performance counter category. This requires administrative rights and should
+		/// be done when the application is installed.
+		/// </summary>
+		public static void Install()
+		{
+			if (PerformanceCounterCategory.Exists(_CategoryName))
+				return;
+
+			CounterCreationDataCollection counters = new CounterCreationDataCollection();
+			counters.Add(new CounterCreationData(_ActiveRenders, "The number of images that are being rendered.", PerformanceCounterType.NumberOfItems32));
+			counters.Add(new CounterCreationData(_QueueLength, "The number of requests that are waiting to render an image.", PerformanceCounterType.NumberOfItems32));
+			counters.Add(new CounterCreationData(_RejectedRenders, "The number of requests that could not render an image.", PerformanceCounterType.NumberOfItems64));
+			counters.Add(new CounterCreationData(_WaitTime, "The average time a request waited before rendering an image.", PerformanceCounterType.AverageTimer32));
+			counters.Add(new CounterCreationData(_WaitTimeBase, "Base counter of the average render wait time.", PerformanceCounterType.AverageBase));
+
+			PerformanceCounterCategory.Create(_CategoryName, "Performance counters of GraphicsMagick.NET.Web.", PerformanceCounterCategoryType.SingleInstance, counters);
+		}
+		///==========================================================================================
+		/// <summary>
+		/// Removes the performance counter category. This requires administrative rights.
+		/// </summary>
+		public static void Uninstall()
+		{
+			if (PerformanceCounterCategory.Exists(_CategoryName))
+				PerformanceCounterCategory.Delete(_CategoryName);
+		}
+		//===========================================================================================
+	}
+	//==============================================================================================
+}
@@ -0,0 +1,97 @@
+﻿//=================================================================================================
+// Copyright 2014-2015 Dirk Lemstra <https://graphicsmagick.codeplex.com/>
+//
+// Licensed under the ImageMagick License (the "License"); you may not use this file except in 
+// compliance with the License. You may obtain a copy of the License at
+//
+//   http://www.imagemagick.org/script/license.php
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the
+// License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing permissions and
+// limitations under the License.
+//=================================================================================================
+
+using System;
+using System.Collections.Generic;
+
+namespace GraphicsMagick.Web
+{
+	//==============================================================================================
+	internal sealed class MemoryImageCache
+	{
+		//===========================================================================================
+		private Dictionary<string, LinkedListNode<KeyValuePair<string, CachedImage>>> _Entries;
+		private LinkedList<KeyValuePair<string, CachedImage>> _Order;
+		private long _MaxSize;
+		private long _Size;
+		private readonly object _SyncRoot = new object();
+		//===========================================================================================
+		private void Remove(LinkedListNode<KeyValuePair<string, CachedImage>> node)
+		{
+			_Entries.Remove(node.Value.Key);
+			_Order.Remove(node);
+			_Size -= node.Value.Value.Data.Length;
+		}
+		//===========================================================================================
+		public MemoryImageCache(long maxSize)
+		{
+			_Entries = new Dictionary<string, LinkedListNode<KeyValuePair<string, CachedImage>>>(StringComparer.OrdinalIgnoreCase);
+			_Order = new LinkedList<KeyValuePair<string, CachedImage>>();
+			_MaxSize = maxSize;
+		}
+		//===========================================================================================
+		public bool IsEnabled
+		{
+			get
+			{
+				return _MaxSize > 0;
+			}
+		}
+		//===========================================================================================
+		public void Add(string key, CachedImage image)
+		{
+			if (image.Data.Length > _MaxSize)
+				return;
+
+			lock (_SyncRoot)
+			{
+				LinkedListNode<KeyValuePair<string, CachedImage>> node;
+				if (_Entries.TryGetValue(key, out node))
+					Remove(node);
+
+				while (_Size + image.Data.Length > _MaxSize)
+					Remove(_Order.Last);
+
+				node = _Order.AddFirst(new KeyValuePair<string, CachedImage>(key, image));
+				_Entries.Add(key, node);
+				_Size += image.Data.Length;
+			}
+		}
+		//===========================================================================================
+		public CachedImage Get(string key, DateTime fileDate)
+		{
+			if (!IsEnabled)
+				return null;
+
+			lock (_SyncRoot)
+			{
+				LinkedListNode<KeyValuePair<string, CachedImage>> node;
+				if (!_Entries.TryGetValue(key, out node))
+					return null;
+
+				if (node.Value.Value.FileDate != fileDate)
+				{
+					Remove(node);
+					return null;
+				}
+
+				_Order.Remove(node);
+				_Order.AddFirst(node);
+				return node.Value.Value;
+			}
+		}
+		//===========================================================================================
+	}
+	//==============================================================================================
+}
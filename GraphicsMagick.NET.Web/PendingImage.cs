@@ -0,0 +1,93 @@
+﻿//=================================================================================================
+// Copyright 2014-2015 Dirk Lemstra <https://graphicsmagick.codeplex.com/>
+//
+// Licensed under the ImageMagick License (the "License"); you may not use this file except in 
+// compliance with the License. You may obtain a copy of the License at
+//
+//   http://www.imagemagick.org/script/license.php
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the
+// License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing permissions and
+// limitations under the License.
+//=================================================================================================
+
+using System;
+using System.Threading;
+using System.Threading.Tasks;
+using System.Web;
+
+namespace GraphicsMagick.Web
+{
+	//==============================================================================================
+	internal sealed class PendingImage
+	{
+		//===========================================================================================
+		private readonly TaskCompletionSource<object> _CompletionSource = new TaskCompletionSource<object>();
+		private Exception _Error;
+		private CachedImage _Image;
+		private static readonly TimeSpan _Timeout = MagickWebSettings.RenderQueueTimeout;
+		//===========================================================================================
+		public void Complete(CachedImage image, Exception error)
+		{
+			_Image = image;
+			_Error = error;
+
+			// The task never faults, the error is reported to every request that waits for the image
+			// by GetImage.
+			_CompletionSource.TrySetResult(null);
+		}
+		//===========================================================================================
+		public void ContinueWith(Action<bool> continuation)
+		{
+			int isCalled = 0;
+			Timer timer = null;
+
+			Action<bool> complete = delegate(bool isCompleted)
+			{
+				if (Interlocked.Exchange(ref isCalled, 1) != 0)
+					return;
+
+				if (timer != null)
+					timer.Dispose();
+
+				continuation(isCompleted);
+			};
+
+			// A request that renders the image for too long is handled like a full queue.
+			timer = new Timer(delegate(object state)
+			{
+				complete(false);
+			}, null, _Timeout, TimeSpan.FromMilliseconds(-1));
+
+			_CompletionSource.Task.ContinueWith(delegate(Task task)
+			{
+				complete(true);
+			}, TaskScheduler.Default);
+		}
+		//===========================================================================================
+		public CachedImage GetImage(bool isCompleted)
+		{
+			if (!isCompleted)
+			{
+				MagickWebPerformanceCounters.AddRejectedRender();
+				throw new RenderRejectedException();
+			}
+
+			if (_Error is RenderRejectedException)
+				throw new RenderRejectedException();
+
+			if (_Error != null)
+				throw new HttpException(500, _Error.Message, _Error);
+
+			return _Image;
+		}
+		//===========================================================================================
+		public CachedImage Wait()
+		{
+			return GetImage(_CompletionSource.Task.Wait(_Timeout));
+		}
+		//===========================================================================================
+	}
+	//==============================================================================================
+}
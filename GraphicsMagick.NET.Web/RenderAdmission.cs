@@ -0,0 +1,240 @@
+﻿//=================================================================================================
+// Copyright 2014-2015 Dirk Lemstra <https://graphicsmagick.codeplex.com/>
+//
+// Licensed under the ImageMagick License (the "License"); you may not use this file except in 
+// compliance with the License. You may obtain a copy of the License at
+//
+//   http://www.imagemagick.org/script/license.php
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the
+// License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing permissions and
+// limitations under the License.
+//=================================================================================================
+
+using System;
+using System.Collections.Generic;
+using System.Threading;
+
+namespace GraphicsMagick.Web
+{
+	//==============================================================================================
+	internal static class RenderAdmission
+	{
+		//===========================================================================================
+		private const int _MaxEstimates = 4096;
+		private static int _ActiveRenders;
+		private static readonly Dictionary<string, KeyValuePair<DateTime, long>> _Estimates = new Dictionary<string, KeyValuePair<DateTime, long>>(StringComparer.OrdinalIgnoreCase);
+		private static readonly int _MaxConcurrentRenders = MagickWebSettings.MaxConcurrentRenders;
+		private static readonly int _MaxQueueLength = MagickWebSettings.MaxRenderQueueLength;
+		private static readonly long _MemoryBudget = MagickWebSettings.RenderMemoryBudget;
+		private static readonly TimeSpan _QueueTimeout = MagickWebSettings.RenderQueueTimeout;
+		private static long _ReservedMemory;
+		private static readonly object _SyncRoot = new object();
+		private static readonly LinkedList<RenderWaiter> _Waiters = new LinkedList<RenderWaiter>();
+		//===========================================================================================
+		private static bool IsEnabled
+		{
+			get
+			{
+				return _MaxConcurrentRenders > 0 || _MemoryBudget > 0;
+			}
+		}
+		//===========================================================================================
+		private static void Acquire(long memory)
+		{
+			_ActiveRenders++;
+			_ReservedMemory += memory;
+			MagickWebPerformanceCounters.SetActiveRenders(_ActiveRenders);
+		}
+		//===========================================================================================
+		private static bool CanAcquire(long memory)
+		{
+			if (_MaxConcurrentRenders > 0 && _ActiveRenders >= _MaxConcurrentRenders)
+				return false;
+
+			// A single image that is larger than the budget is allowed when nothing else is rendered.
+			if (_MemoryBudget > 0 && _ReservedMemory > 0 && _ReservedMemory + memory > _MemoryBudget)
+				return false;
+
+			return true;
+		}
+		//===========================================================================================
+		private static long GetMemory(int width, int height)
+		{
+			return (long)width * height * 4 * (Quantum.Depth / 8);
+		}
+		//===========================================================================================
+		private static void SetEstimate(string fileName, DateTime fileDate, long memory)
+		{
+			lock (_Estimates)
+			{
+				KeyValuePair<DateTime, long> estimate;
+				if (_Estimates.TryGetValue(fileName, out estimate) && estimate.Key == fileDate && estimate.Value >= memory)
+					return;
+
+				if (_Estimates.Count >= _MaxEstimates)
+					_Estimates.Clear();
+
+				_Estimates[fileName] = new KeyValuePair<DateTime, long>(fileDate, memory);
+			}
+		}
+		//===========================================================================================
+		private static void OnTimeout(object state)
+		{
+			RenderWaiter waiter = (RenderWaiter)state;
+
+			lock (_SyncRoot)
+			{
+				// The waiter was already started by Exit when it is no longer in the queue.
+				if (!_Waiters.Remove(waiter))
+					return;
+
+				MagickWebPerformanceCounters.SetQueueLength(_Waiters.Count);
+			}
+
+			MagickWebPerformanceCounters.AddRejectedRender();
+			waiter.Complete(false);
+		}
+		//===========================================================================================
+		private static List<RenderWaiter> StartWaiters()
+		{
+			List<RenderWaiter> waiters = new List<RenderWaiter>();
+
+			// The waiters are started in the order they were queued, a large image at the start of
+			// the queue is not passed by the smaller images that were queued after it.
+			while (_Waiters.Count > 0 && CanAcquire(_Waiters.First.Value.Memory))
+			{
+				RenderWaiter waiter = _Waiters.First.Value;
+				_Waiters.RemoveFirst();
+
+				Acquire(waiter.Memory);
+				waiters.Add(waiter);
+			}
+
+			MagickWebPerformanceCounters.SetQueueLength(_Waiters.Count);
+			return waiters;
+		}
+		//===========================================================================================
+		public static long EstimateMemory(string fileName, DateTime fileDate)
+		{
+			if (_MemoryBudget <= 0)
+				return 0;
+
+			lock (_Estimates)
+			{
+				KeyValuePair<DateTime, long> estimate;
+				if (_Estimates.TryGetValue(fileName, out estimate) && estimate.Key == fileDate)
+					return estimate.Value;
+			}
+
+			MagickImageInfo info = new MagickImageInfo(fileName);
+			long memory = GetMemory(info.Width, info.Height);
+
+			SetEstimate(fileName, fileDate, memory);
+			return memory;
+		}
+		//===========================================================================================
+		public static void BeginEnter(long memory, Action<bool> callback)
+		{
+			if (!IsEnabled)
+			{
+				callback(true);
+				return;
+			}
+
+			bool isAdmitted;
+
+			lock (_SyncRoot)
+			{
+				if (_Waiters.Count == 0 && CanAcquire(memory))
+				{
+					Acquire(memory);
+					isAdmitted = true;
+				}
+				else if (_Waiters.Count < _MaxQueueLength)
+				{
+					// The callback is called by Exit when the render can be started or by the timer of
+					// the waiter when it has been in the queue for too long, no thread waits for it.
+					RenderWaiter waiter = new RenderWaiter(memory, callback);
+					_Waiters.AddLast(waiter);
+					waiter.Start(_QueueTimeout, OnTimeout);
+
+					MagickWebPerformanceCounters.SetQueueLength(_Waiters.Count);
+					return;
+				}
+				else
+				{
+					isAdmitted = false;
+				}
+			}
+
+			if (!isAdmitted)
+				MagickWebPerformanceCounters.AddRejectedRender();
+
+			callback(isAdmitted);
+		}
+		//===========================================================================================
+		public static void Enter(long memory)
+		{
+			bool? isAdmitted = null;
+			object syncRoot = new object();
+
+			BeginEnter(memory, delegate(bool result)
+			{
+				lock (syncRoot)
+				{
+					isAdmitted = result;
+					Monitor.Pulse(syncRoot);
+				}
+			});
+
+			lock (syncRoot)
+			{
+				while (isAdmitted == null)
+					Monitor.Wait(syncRoot);
+			}
+
+			if (!isAdmitted.Value)
+				throw new RenderRejectedException();
+		}
+		//===========================================================================================
+		public static void UpdateEstimate(string fileName, DateTime fileDate, MagickImage image)
+		{
+			if (_MemoryBudget <= 0)
+				return;
+
+			// The next render of the file reserves the memory of the image that was created by the
+			// script when it is larger than the source image.
+			SetEstimate(fileName, fileDate, GetMemory(image.Width, image.Height));
+		}
+		//===========================================================================================
+		public static void Exit(long memory)
+		{
+			if (!IsEnabled)
+				return;
+
+			List<RenderWaiter> waiters;
+
+			lock (_SyncRoot)
+			{
+				_ActiveRenders--;
+				_ReservedMemory -= memory;
+				MagickWebPerformanceCounters.SetActiveRenders(_ActiveRenders);
+
+				waiters = StartWaiters();
+			}
+
+			// The callbacks are not executed on the thread of the render that exits.
+			foreach (RenderWaiter waiter in waiters)
+			{
+				ThreadPool.QueueUserWorkItem(delegate(object state)
+				{
+					((RenderWaiter)state).Complete(true);
+				}, waiter);
+			}
+		}
+		//===========================================================================================
+	}
+	//==============================================================================================
+}
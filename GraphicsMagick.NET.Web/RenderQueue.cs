@@ -0,0 +1,72 @@
+﻿//=================================================================================================
+// Copyright 2014-2015 Dirk Lemstra <https://graphicsmagick.codeplex.com/>
+//
+// Licensed under the ImageMagick License (the "License"); you may not use this file except in 
+// compliance with the License. You may obtain a copy of the License at
+//
+//   http://www.imagemagick.org/script/license.php
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the
+// License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing permissions and
+// limitations under the License.
+//=================================================================================================
+
+using System;
+using System.Collections.Concurrent;
+using System.Threading;
+
+namespace GraphicsMagick.Web
+{
+	//==============================================================================================
+	internal static class RenderQueue
+	{
+		//===========================================================================================
+		private static readonly BlockingCollection<Action> _Actions = new BlockingCollection<Action>(Math.Max(1, MagickWebSettings.MaxRenderQueueLength));
+		private static readonly object _SyncRoot = new object();
+		private static volatile Thread[] _Threads;
+		//===========================================================================================
+		private static void ExecuteActions()
+		{
+			foreach (Action action in _Actions.GetConsumingEnumerable())
+			{
+				action();
+			}
+		}
+		//===========================================================================================
+		private static void StartThreads()
+		{
+			if (_Threads != null)
+				return;
+
+			lock (_SyncRoot)
+			{
+				if (_Threads != null)
+					return;
+
+				int count = MagickWebSettings.RenderThreads;
+				if (count < 1)
+					count = Environment.ProcessorCount;
+
+				Thread[] threads = new Thread[count];
+				for (int i = 0; i < count; i++)
+				{
+					threads[i] = new Thread(ExecuteActions);
+					threads[i].IsBackground = true;
+					threads[i].Name = "GraphicsMagick.Web.RenderQueue";
+					threads[i].Start();
+				}
+
+				_Threads = threads;
+			}
+		}
+		//===========================================================================================
+		public static bool TryAdd(Action action)
+		{
+			StartThreads();
+			return _Actions.TryAdd(action);
+		}
+		//===========================================================================================
+	}
+	//==============================================================================================
+}
@@ -0,0 +1,56 @@
+﻿//=================================================================================================
+// Copyright 2014-2015 Dirk Lemstra <https://graphicsmagick.codeplex.com/>
+//
+// Licensed under the ImageMagick License (the "License"); you may not use this file except in 
+// compliance with the License. You may obtain a copy of the License at
+//
+//   http://www.imagemagick.org/script/license.php
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the
+// License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing permissions and
+// limitations under the License.
+//=================================================================================================
+
+using System;
+using System.Diagnostics;
+using System.Threading;
+
+namespace GraphicsMagick.Web
+{
+	//==============================================================================================
+	internal sealed class RenderWaiter
+	{
+		//===========================================================================================
+		private readonly Action<bool> _Callback;
+		private readonly Stopwatch _Stopwatch = Stopwatch.StartNew();
+		private Timer _Timer;
+		//===========================================================================================
+		public RenderWaiter(long memory, Action<bool> callback)
+		{
+			Memory = memory;
+			_Callback = callback;
+		}
+		//===========================================================================================
+		public long Memory
+		{
+			get;
+			private set;
+		}
+		//===========================================================================================
+		public void Complete(bool isAdmitted)
+		{
+			_Timer.Dispose();
+			MagickWebPerformanceCounters.AddWaitTime(_Stopwatch.ElapsedTicks);
+
+			_Callback(isAdmitted);
+		}
+		//===========================================================================================
+		public void Start(TimeSpan timeout, TimerCallback onTimeout)
+		{
+			_Timer = new Timer(onTimeout, this, timeout, TimeSpan.FromMilliseconds(-1));
+		}
+		//===========================================================================================
+	}
+	//==============================================================================================
+}
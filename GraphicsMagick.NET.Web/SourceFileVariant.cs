@@ -0,0 +1,52 @@
+﻿//=================================================================================================
+// Copyright 2014-2015 Dirk Lemstra <https://graphicsmagick.codeplex.com/>
+//
+// Licensed under the ImageMagick License (the "License"); you may not use this file except in 
+// compliance with the License. You may obtain a copy of the License at
+//
+//   http://www.imagemagick.org/script/license.php
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the
+// License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing permissions and
+// limitations under the License.
+//=================================================================================================
+
+using System;
+using System.Threading;
+
+namespace GraphicsMagick.Web
+{
+	//==============================================================================================
+	internal sealed class SourceFileVariant
+	{
+		//===========================================================================================
+		private int _Hits;
+		//===========================================================================================
+		public SourceFileVariant(Action render)
+		{
+			Render = render;
+		}
+		//===========================================================================================
+		public int Hits
+		{
+			get
+			{
+				return _Hits;
+			}
+		}
+		//===========================================================================================
+		public void AddHit()
+		{
+			Interlocked.Increment(ref _Hits);
+		}
+		//===========================================================================================
+		public Action Render
+		{
+			get;
+			private set;
+		}
+		//===========================================================================================
+	}
+	//==============================================================================================
+}
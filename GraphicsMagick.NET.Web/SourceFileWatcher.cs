@@ -0,0 +1,295 @@
+﻿//=================================================================================================
+// Copyright 2014-2015 Dirk Lemstra <https://graphicsmagick.codeplex.com/>
+//
+// Licensed under the ImageMagick License (the "License"); you may not use this file except in 
+// compliance with the License. You may obtain a copy of the License at
+//
+//   http://www.imagemagick.org/script/license.php
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the
+// License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing permissions and
+// limitations under the License.
+//=================================================================================================
+
+using System;
+using System.Collections.Concurrent;
+using System.Collections.Generic;
+using System.Diagnostics.CodeAnalysis;
+using System.IO;
+using System.Linq;
+using System.Threading;
+using System.Web.Hosting;
+
+namespace GraphicsMagick.Web
+{
+	//==============================================================================================
+	internal static class SourceFileWatcher
+	{
+		//===========================================================================================
+		private const int _MaxFiles = 8192;
+		private const int _MaxRenders = 8;
+		private const int _MaxWatchers = 16;
+		private const int _RenderDelay = 1000;
+		private static readonly ConcurrentDictionary<string, bool> _Directories = new ConcurrentDictionary<string, bool>(StringComparer.OrdinalIgnoreCase);
+		private static readonly Dictionary<string, DateTime> _Files = new Dictionary<string, DateTime>(StringComparer.OrdinalIgnoreCase);
+		private static readonly bool _IsEnabled = MagickWebSettings.WatchSourceFiles;
+		private static readonly bool _RenderOnChange = MagickWebSettings.RenderOnChange;
+		private static readonly Dictionary<string, Timer> _Timers = new Dictionary<string, Timer>(StringComparer.OrdinalIgnoreCase);
+		private static readonly ConcurrentDictionary<string, ConcurrentDictionary<string, SourceFileVariant>> _Variants = new ConcurrentDictionary<string, ConcurrentDictionary<string, SourceFileVariant>>(StringComparer.OrdinalIgnoreCase);
+		private static int _Version;
+		private static readonly List<FileSystemWatcher> _Watchers = new List<FileSystemWatcher>();
+		//===========================================================================================
+		private static FileSystemWatcher CreateWatcher(string directory)
+		{
+			FileSystemWatcher watcher = null;
+
+			try
+			{
+				watcher = new FileSystemWatcher(directory);
+				watcher.IncludeSubdirectories = true;
+				watcher.NotifyFilter = NotifyFilters.DirectoryName | NotifyFilters.FileName | NotifyFilters.LastWrite | NotifyFilters.Size;
+				watcher.Changed += OnChanged;
+				watcher.Created += OnChanged;
+				watcher.Deleted += OnChanged;
+				watcher.Renamed += OnRenamed;
+				watcher.Error += OnError;
+				watcher.EnableRaisingEvents = true;
+				return watcher;
+			}
+			catch (ArgumentException)
+			{
+			}
+			catch (IOException)
+			{
+			}
+
+			if (watcher != null)
+				watcher.Dispose();
+
+			return null;
+		}
+		//===========================================================================================
+		private static string GetDirectory(string directory)
+		{
+			return directory[directory.Length - 1] == '\\' ? directory : directory + "\\";
+		}
+		//===========================================================================================
+		private static DateTime GetFileDate(string fileName)
+		{
+			FileInfo file = new FileInfo(fileName);
+			return file.Exists ? file.LastWriteTime : DateTime.MinValue;
+		}
+		//===========================================================================================
+		private static string GetRoot(string directory)
+		{
+			// The cache directory and the application are watched with a single watcher that
+			// includes the sub directories, other directories get their own watcher.
+			string cacheDirectory = MagickWebSettings.CacheDirectory;
+			if (!string.IsNullOrEmpty(cacheDirectory) && directory.StartsWith(cacheDirectory, StringComparison.OrdinalIgnoreCase))
+				return cacheDirectory;
+
+			string applicationDirectory = HostingEnvironment.ApplicationPhysicalPath;
+			if (!string.IsNullOrEmpty(applicationDirectory) && directory.StartsWith(GetDirectory(applicationDirectory), StringComparison.OrdinalIgnoreCase))
+				return GetDirectory(applicationDirectory);
+
+			return directory;
+		}
+		//===========================================================================================
+		private static bool IsWatched(string fileName)
+		{
+			string directory = GetDirectory(Path.GetDirectoryName(fileName));
+
+			bool isWatched;
+			if (_Directories.TryGetValue(directory, out isWatched))
+				return isWatched;
+
+			lock (_Watchers)
+			{
+				isWatched = _Watchers.Any(watcher => directory.StartsWith(GetDirectory(watcher.Path), StringComparison.OrdinalIgnoreCase));
+
+				if (!isWatched && _Watchers.Count < _MaxWatchers)
+				{
+					FileSystemWatcher watcher = CreateWatcher(GetRoot(directory));
+					if (watcher != null)
+					{
+						_Watchers.Add(watcher);
+						isWatched = true;
+					}
+				}
+
+				// A directory that cannot be watched is also stored so it is only tried once.
+				if (_Directories.Count >= _MaxFiles)
+					_Directories.Clear();
+
+				_Directories[directory] = isWatched;
+			}
+
+			return isWatched;
+		}
+		//===========================================================================================
+		private static void OnChanged(object sender, FileSystemEventArgs arguments)
+		{
+			Remove(arguments.FullPath);
+		}
+		//===========================================================================================
+		private static void OnError(object sender, ErrorEventArgs arguments)
+		{
+			FileSystemWatcher watcher = (FileSystemWatcher)sender;
+
+			// A watcher of a directory that was removed can no longer be used.
+			if (!Directory.Exists(watcher.Path))
+			{
+				lock (_Watchers)
+				{
+					_Watchers.Remove(watcher);
+					_Directories.Clear();
+				}
+
+				watcher.Dispose();
+			}
+
+			// The internal buffer of the watcher overflowed so all the files have to be checked again.
+			lock (_Files)
+			{
+				_Files.Clear();
+				_Version++;
+			}
+		}
+		//===========================================================================================
+		private static void OnRenamed(object sender, RenamedEventArgs arguments)
+		{
+			Remove(arguments.OldFullPath);
+			Remove(arguments.FullPath);
+		}
+		//===========================================================================================
+		private static void Remove(string fileName)
+		{
+			Invalidate(fileName);
+
+			if (!_RenderOnChange || !_Variants.ContainsKey(fileName))
+				return;
+
+			lock (_Timers)
+			{
+				Timer timer;
+				if (_Timers.TryGetValue(fileName, out timer))
+					timer.Change(_RenderDelay, Timeout.Infinite);
+				else
+					_Timers.Add(fileName, new Timer(Render, fileName, _RenderDelay, Timeout.Infinite));
+			}
+		}
+		//===========================================================================================
+		[SuppressMessage("Microsoft.Design", "CA1031:DoNotCatchGeneralExceptionTypes")]
+		private static void Render(object state)
+		{
+			string fileName = (string)state;
+
+			lock (_Timers)
+			{
+				Timer timer;
+				if (_Timers.TryGetValue(fileName, out timer))
+				{
+					timer.Dispose();
+					_Timers.Remove(fileName);
+				}
+			}
+
+			ConcurrentDictionary<string, SourceFileVariant> fileVariants;
+			if (!_Variants.TryRemove(fileName, out fileVariants))
+				return;
+
+			SourceFileVariant[] variants = fileVariants.Values.OrderByDescending(variant => variant.Hits).Take(_MaxRenders).ToArray();
+
+			if (!File.Exists(fileName))
+				return;
+
+			foreach (SourceFileVariant variant in variants)
+			{
+				try
+				{
+					variant.Render();
+				}
+				catch (RenderRejectedException)
+				{
+					return;
+				}
+				catch (Exception)
+				{
+					// The request of the image will render it again and report the error.
+				}
+			}
+		}
+		//===========================================================================================
+		public static void AddHit(string fileName, string cacheFileName, MagickScriptHandler handler)
+		{
+			if (!_RenderOnChange)
+				return;
+
+			ConcurrentDictionary<string, SourceFileVariant> fileVariants;
+			SourceFileVariant variant;
+
+			if (_Variants.TryGetValue(fileName, out fileVariants) && fileVariants.TryGetValue(cacheFileName, out variant))
+			{
+				variant.AddHit();
+				return;
+			}
+
+			if (_Variants.Count >= _MaxFiles)
+				_Variants.Clear();
+
+			fileVariants = _Variants.GetOrAdd(fileName, key => new ConcurrentDictionary<string, SourceFileVariant>(StringComparer.OrdinalIgnoreCase));
+			variant = fileVariants.GetOrAdd(cacheFileName, key => new SourceFileVariant(handler.CreateRender()));
+			variant.AddHit();
+		}
+		//===========================================================================================
+		public static bool Exists(string fileName)
+		{
+			return GetLastWriteTime(fileName) != DateTime.MinValue;
+		}
+		//===========================================================================================
+		public static DateTime GetLastWriteTime(string fileName)
+		{
+			if (!_IsEnabled || !IsWatched(fileName))
+				return GetFileDate(fileName);
+
+			DateTime fileDate;
+			int version;
+
+			lock (_Files)
+			{
+				if (_Files.TryGetValue(fileName, out fileDate))
+					return fileDate;
+
+				version = _Version;
+			}
+
+			fileDate = GetFileDate(fileName);
+
+			lock (_Files)
+			{
+				// Don't store the date when a file changed while it was being read.
+				if (version != _Version)
+					return fileDate;
+
+				if (_Files.Count >= _MaxFiles)
+					_Files.Clear();
+
+				_Files[fileName] = fileDate;
+			}
+
+			return fileDate;
+		}
+		//===========================================================================================
+		public static void Invalidate(string fileName)
+		{
+			lock (_Files)
+			{
+				_Files.Remove(fileName);
+				_Version++;
+			}
+		}
+		//===========================================================================================
+	}
+	//==============================================================================================
+}
@@ -0,0 +1,149 @@
+﻿//=================================================================================================
+// Copyright 2014-2015 Dirk Lemstra <https://graphicsmagick.codeplex.com/>
+//
+// Licensed under the ImageMagick License (the "License"); you may not use this file except in 
+// compliance with the License. You may obtain a copy of the License at
+//
+//   http://www.imagemagick.org/script/license.php
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the
+// License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing permissions and
+// limitations under the License.
+//=================================================================================================
+
+using System;
+using System.Collections.Generic;
+using System.IO;
+
+namespace GraphicsMagick.Web
+{
+	//==============================================================================================
+	internal sealed class SourceImageCache
+	{
+		//===========================================================================================
+		private sealed class Entry
+		{
+			public DateTime FileDate;
+			public MagickImage Image;
+			public string Key;
+			public long Size;
+		}
+		//===========================================================================================
+		private Dictionary<string, LinkedListNode<Entry>> _Entries;
+		private LinkedList<Entry> _Order;
+		private long _MaxSize;
+		private long _Size;
+		private readonly object _SyncRoot = new object();
+		//===========================================================================================
+		private void Add(string key, DateTime fileDate, MagickImage image)
+		{
+			long size = GetSize(image);
+			if (size > _MaxSize)
+			{
+				image.Dispose();
+				return;
+			}
+
+			lock (_SyncRoot)
+			{
+				LinkedListNode<Entry> node;
+				if (_Entries.TryGetValue(key, out node))
+					Remove(node);
+
+				while (_Size + size > _MaxSize)
+					Remove(_Order.Last);
+
+				Entry entry = new Entry()
+				{
+					FileDate = fileDate,
+					Image = image,
+					Key = key,
+					Size = size
+				};
+
+				_Entries.Add(key, _Order.AddFirst(entry));
+				_Size += size;
+			}
+		}
+		//===========================================================================================
+		private static string CreateKey(string fileName, MagickReadSettings settings)
+		{
+			// The scripts that read the same file with the same settings share the decoded image.
+			string key = Path.GetFullPath(fileName);
+			if (settings == null)
+				return key;
+
+			return key + "|" + settings.ToString();
+		}
+		//===========================================================================================
+		private MagickImage Get(string key, DateTime fileDate)
+		{
+			lock (_SyncRoot)
+			{
+				LinkedListNode<Entry> node;
+				if (!_Entries.TryGetValue(key, out node))
+					return null;
+
+				if (node.Value.FileDate != fileDate)
+				{
+					Remove(node);
+					return null;
+				}
+
+				_Order.Remove(node);
+				_Order.AddFirst(node);
+				return node.Value.Image.Clone();
+			}
+		}
+		//===========================================================================================
+		private static long GetSize(MagickImage image)
+		{
+			return (long)image.Width * image.Height * 4 * (Quantum.Depth / 8);
+		}
+		//===========================================================================================
+		private void Remove(LinkedListNode<Entry> node)
+		{
+			_Entries.Remove(node.Value.Key);
+			_Order.Remove(node);
+			_Size -= node.Value.Size;
+			node.Value.Image.Dispose();
+		}
+		//===========================================================================================
+		public SourceImageCache(long maxSize)
+		{
+			_Entries = new Dictionary<string, LinkedListNode<Entry>>(StringComparer.OrdinalIgnoreCase);
+			_Order = new LinkedList<Entry>();
+			_MaxSize = maxSize;
+		}
+		//===========================================================================================
+		public bool IsEnabled
+		{
+			get
+			{
+				return _MaxSize > 0;
+			}
+		}
+		//===========================================================================================
+		public MagickImage Read(string fileName, DateTime fileDate, MagickReadSettings settings)
+		{
+			if (!IsEnabled || (settings != null && settings.PixelStorage != null))
+				return new MagickImage(fileName, settings);
+
+			// The entry is replaced when the modification date of the file changes. The clone shares
+			// the pixels until the script modifies them.
+			string key = CreateKey(fileName, settings);
+
+			MagickImage image = Get(key, fileDate);
+			if (image != null)
+				return image;
+
+			image = new MagickImage(fileName, settings);
+			MagickImage result = image.Clone();
+			Add(key, fileDate, image);
+			return result;
+		}
+		//===========================================================================================
+	}
+	//==============================================================================================
+}
@@ -45,6 +45,16 @@ namespace GraphicsMagick
 		Initialize(geometry);
 	}
 	//==============================================================================================
+	MagickGeometry::MagickGeometry(MagickGeometry^ geometry)
+	{
+		Initialize(geometry->X, geometry->Y, geometry->Width, geometry->Height, geometry->IsPercentage);
+		IgnoreAspectRatio = geometry->IgnoreAspectRatio;
+		Less = geometry->Less;
+		Greater = geometry->Greater;
+		LimitPixels = geometry->LimitPixels;
+		FillArea = geometry->FillArea;
+	}
+	//==============================================================================================
 	const Magick::Geometry* MagickGeometry::CreateGeometry()
 	{
 		Magick::Geometry* result = new Magick::Geometry(Width, Height, Math::Abs(X), Math::Abs(Y), X < 0, Y < 0);
@@ -36,6 +36,8 @@ namespace GraphicsMagick
 		//===========================================================================================
 		MagickGeometry(Magick::Geometry geometry);
 		//===========================================================================================
+		MagickGeometry(MagickGeometry^ geometry);
+		//===========================================================================================
 		const Magick::Geometry* CreateGeometry();
 		//===========================================================================================
 	public:
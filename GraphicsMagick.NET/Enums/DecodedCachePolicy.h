@@ -0,0 +1,33 @@
+//=================================================================================================
+// Copyright 2014-2015 Dirk Lemstra <https://graphicsmagick.codeplex.com/>
+//
+// Licensed under the ImageMagick License (the "License"); you may not use this file except in 
+// compliance with the License. You may obtain a copy of the License at
+//
+//   http://www.imagemagick.org/script/license.php
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the
+// License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing permissions and
+// limitations under the License.
+//=================================================================================================
+#pragma once
+
+#include "Stdafx.h"
+
+namespace GraphicsMagick
+{
+	///=============================================================================================
+	///<summary>
+	/// Specifies how the decoded cache (MPC files) is used when an image is read from a file. The
+	/// cache is only used when it is newer than the file, ReadWrite also creates the cache when it
+	/// is missing or outdated.
+	///</summary>
+	public enum class DecodedCachePolicy
+	{
+		Disabled,
+		ReadOnly,
+		ReadWrite
+	};
+	//==============================================================================================
+}
\ No newline at end of file
@@ -0,0 +1,33 @@
+//=================================================================================================
+// Copyright 2014-2015 Dirk Lemstra <https://graphicsmagick.codeplex.com/>
+//
+// Licensed under the ImageMagick License (the "License"); you may not use this file except in 
+// compliance with the License. You may obtain a copy of the License at
+//
+//   http://www.imagemagick.org/script/license.php
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the
+// License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing permissions and
+// limitations under the License.
+//=================================================================================================
+#pragma once
+
+#include "Stdafx.h"
+
+namespace GraphicsMagick
+{
+	///=============================================================================================
+	///<summary>
+	/// Specifies the 8-bit YUV layouts (BT.601, limited range) that are used by video pipelines.
+	/// I420 contains a Y plane followed by an U and a V plane, NV12 contains a Y plane followed
+	/// by an interleaved UV plane and YUY2 contains the packed values Y0 U Y1 V.
+	///</summary>
+	public enum class YuvFormat
+	{
+		I420,
+		NV12,
+		YUY2
+	};
+	//==============================================================================================
+}
\ No newline at end of file
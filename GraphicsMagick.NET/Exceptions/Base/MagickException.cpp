@@ -25,6 +25,11 @@ namespace GraphicsMagick
 	{
 	}
 	//==============================================================================================
+	MagickException::MagickException(String^ message, Exception^ innerException)
+		: Exception(message, innerException)
+	{
+	}
+	//==============================================================================================
 	MagickException^ MagickException::Create(const Magick::Exception& exception)
 	{
 		const Magick::Warning* warning = dynamic_cast<const Magick::Warning*>(&exception);
@@ -27,6 +27,8 @@ namespace GraphicsMagick
 		//===========================================================================================
 		MagickException(String^ message);
 		//===========================================================================================
+		MagickException(String^ message, Exception^ innerException);
+		//===========================================================================================
 	internal:
 		//===========================================================================================
 		static MagickException^ Create(const Magick::Exception& exception);
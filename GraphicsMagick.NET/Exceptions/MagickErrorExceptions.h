@@ -29,6 +29,9 @@ namespace GraphicsMagick
 		MagickErrorException(String^ message)
 			: MagickException(message) {};
 		//===========================================================================================
+		MagickErrorException(String^ message, Exception^ innerException)
+			: MagickException(message, innerException) {};
+		//===========================================================================================
 		static MagickErrorException^ Create(const Magick::Error& exception);
 		//===========================================================================================
 	};
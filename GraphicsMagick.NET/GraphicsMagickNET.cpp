@@ -13,9 +13,11 @@
 //=================================================================================================
 #include "Stdafx.h"
 #include "GraphicsMagickNET.h"
+#include "Exceptions\Base\MagickException.h"
 #include "Helpers\EnumHelper.h"
 #include "Helpers\FileHelper.h"
 
+using namespace System::Diagnostics;
 using namespace System::IO;
 using namespace System::Security;
 
@@ -41,6 +43,45 @@ namespace GraphicsMagick
 		}
 	}
 	//==============================================================================================
+	void GraphicsMagickNET::LoadConfiguration(WarmUpOptions options)
+	{
+		MagickLib::ExceptionInfo exceptionInfo;
+		MagickLib::GetExceptionInfo(&exceptionInfo);
+
+		try
+		{
+			// Looking up "*" parses the configuration file and returns the first entry.
+			if (((int)options & (int)WarmUpOptions::Colors) != 0)
+				(void) MagickLib::GetColorInfo("*", &exceptionInfo);
+			if (((int)options & (int)WarmUpOptions::Delegates) != 0)
+				(void) MagickLib::GetDelegateInfo("*", "*", &exceptionInfo);
+			if (((int)options & (int)WarmUpOptions::Fonts) != 0)
+				(void) MagickLib::GetTypeInfo("*", &exceptionInfo);
+
+			Magick::throwException(exceptionInfo, true);
+			MagickLib::DestroyExceptionInfo(&exceptionInfo);
+		}
+		catch(Magick::Exception& exception)
+		{
+			MagickException::Throw(exception);
+		}
+	}
+	//==============================================================================================
+	void GraphicsMagickNET::LoadPixelCache()
+	{
+		try
+		{
+			Magick::Image image(Magick::Geometry(1, 1), Magick::Color(0, 0, 0));
+			image.modifyImage();
+			(void) image.getPixels(0, 0, 1, 1);
+			image.syncPixels();
+		}
+		catch(Magick::Exception& exception)
+		{
+			MagickException::Throw(exception);
+		}
+	}
+	//==============================================================================================
 	void GraphicsMagickNET::OnLog(const Magick::ExceptionType type, const char* text)
 	{
 		if (text == NULL)
@@ -95,13 +136,14 @@ namespace GraphicsMagick
 	//==============================================================================================
 	MagickFormatInfo^ GraphicsMagickNET::GetFormatInformation(MagickFormat format)
 	{
-		for each (MagickFormatInfo^ formatInfo in SupportedFormats)
-		{
-			if (formatInfo->Format == format)
-				return formatInfo;
-		}
-
-		return nullptr;
+		return MagickFormatInfo::Get(format);
+	}
+	//==============================================================================================
+	void GraphicsMagickNET::Initialize()
+	{
+		// The xml files are embedded as IMAGEMAGICK resources and GraphicsMagick only falls back to
+		// them when the files cannot be found in the configure path.
+		SetEnv("MAGICK_CONFIGURE_PATH", "");
 	}
 	//==============================================================================================
 	void GraphicsMagickNET::Initialize(String^ path)
@@ -148,4 +190,26 @@ namespace GraphicsMagick
 		SetEnv("MAGICK_GHOSTSCRIPT_PATH", CheckDirectory(path));
 	}
 	//==============================================================================================
+	TimeSpan GraphicsMagickNET::WarmUp(IEnumerable<MagickFormat>^ formats, WarmUpOptions options)
+	{
+		Throw::IfNull("formats", formats);
+
+		Stopwatch^ stopwatch = Stopwatch::StartNew();
+
+		for each (MagickFormat format in formats)
+		{
+			if (format == MagickFormat::Unknown)
+				continue;
+
+			Throw::IfTrue("formats", MagickFormatInfo::Get(format) == nullptr, "Unable to find the coder of format: {0}", format);
+		}
+
+		LoadConfiguration(options);
+
+		if (((int)options & (int)WarmUpOptions::PixelCache) != 0)
+			LoadPixelCache();
+
+		return stopwatch->Elapsed;
+	}
+	//==============================================================================================
 }
\ No newline at end of file
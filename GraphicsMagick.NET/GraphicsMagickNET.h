@@ -14,6 +14,7 @@
 #pragma once
 
 #include "Enums\ExceptionTypes.h"
+#include "Enums\WarmUpOptions.h"
 #include "Events\LogEventArgs.h"
 #include "MagickFormatInfo.h"
 
@@ -46,6 +47,10 @@ namespace GraphicsMagick
 		//===========================================================================================
 		static void CheckImageMagickFiles(String^ path);
 		//===========================================================================================
+		static void LoadConfiguration(WarmUpOptions options);
+		//===========================================================================================
+		static void LoadPixelCache();
+		//===========================================================================================
 		static void OnLog(const Magick::ExceptionType type, const char* text);
 		//===========================================================================================
 		static void SetEnv(const char* name, String^ value);
@@ -81,6 +86,16 @@ namespace GraphicsMagick
 		static MagickFormatInfo^ GetFormatInformation(MagickFormat format);
 		///==========================================================================================
 		///<summary>
+		/// Initializes GraphicsMagick with the xml files that are embedded in the assembly. The files
+		/// are read from the resources of the assembly in memory, there is no need to extract them.
+		/// GraphicsMagick still searches its default directories first and uses the files that it
+		/// finds there instead of the embedded files. The AnyCPU library still extracts the files
+		/// to its cache directory, because the assembly that it loads is renamed and GraphicsMagick
+		/// cannot find the resources in it.
+		///</summary>
+		static void Initialize();
+		///==========================================================================================
+		///<summary>
 		/// Adds the specified path to the environment path. You should place the ImageMagick
 		/// xml files in that directory.
 		///</summary>
@@ -111,6 +126,16 @@ namespace GraphicsMagick
 		///</summary>
 		///<param name="path">The path of the Ghostscript directory.</param>
 		static void SetGhostscriptDirectory(String^ path);
+		///==========================================================================================
+		///<summary>
+		/// Loads the coders of the specified formats and initializes the specified subsystems so
+		/// the first image that is read does not have to wait for them.
+		///</summary>
+		///<param name="formats">The formats whose coders should be loaded.</param>
+		///<param name="options">The subsystems that should be initialized.</param>
+		///<returns>The time that was spent.</returns>
+		///<exception cref="MagickException"/>
+		static TimeSpan WarmUp(IEnumerable<MagickFormat>^ formats, WarmUpOptions options);
 		//===========================================================================================
 	};
 	//==============================================================================================
@@ -14,6 +14,8 @@
 #include "Stdafx.h"
 #include "FileHelper.h"
 
+using namespace System::IO;
+
 namespace GraphicsMagick
 {
 	//==============================================================================================
@@ -28,4 +30,35 @@ namespace GraphicsMagick
 		return AppDomain::CurrentDomain->BaseDirectory + fileName->Substring(1);
 	}
 	//==============================================================================================
+	String^ FileHelper::GetFilePath(String^ fileName)
+	{
+		if (fileName->Length > 248)
+			return nullptr;
+
+		String^ path = fileName;
+
+		int colonIndex = fileName->IndexOf(':');
+		if (colonIndex != -1)
+		{
+			if (colonIndex + 1 == fileName->Length)
+				return nullptr;
+
+			if (!fileName->Contains("\\"))
+				return nullptr;
+
+			if (fileName[colonIndex + 1] != '/' && fileName[colonIndex + 1] != '\\')
+				path = path->Substring(colonIndex + 1);
+		}
+
+		path = Path::GetFullPath(path);
+		if (path->EndsWith("]", StringComparison::OrdinalIgnoreCase))
+		{
+			int endIndex = path->IndexOf("[", StringComparison::OrdinalIgnoreCase);
+			if (endIndex != -1)
+				path = path->Substring(0, endIndex);
+		}
+
+		return path;
+	}
+	//==============================================================================================
 }
\ No newline at end of file
@@ -23,6 +23,8 @@ namespace GraphicsMagick
 		//===========================================================================================
 		static String^ CheckForBaseDirectory(String^ fileName);
 		//===========================================================================================
+		static String^ GetFilePath(String^ fileName);
+		//===========================================================================================
 	};
 	//==============================================================================================
 }
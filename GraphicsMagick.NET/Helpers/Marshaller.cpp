@@ -18,15 +18,6 @@ using namespace System::Runtime::InteropServices;
 namespace GraphicsMagick
 {
 #pragma warning(disable: 6001)
-	//==============================================================================================
-	template <typename TStorageType>
-	TStorageType* Marshaller::MarshalStorageType(array<Byte>^ bytes)
-	{
-		int length = bytes->Length / sizeof(TStorageType);
-		TStorageType* unmanagedValue = new TStorageType[length];
-		Marshal::Copy(bytes, 0, IntPtr(unmanagedValue), bytes->Length);
-		return unmanagedValue;
-	}
 	//==============================================================================================
 	unsigned char* Marshaller::Marshal(array<Byte>^ bytes)
 	{
@@ -48,29 +39,6 @@ namespace GraphicsMagick
 		value->updateNoCopy(unmanagedValue, bytes->Length);
 	}
 	//==============================================================================================
-	void* Marshaller::Marshal(array<Byte>^ values, StorageType storageType)
-	{
-		Throw::IfNullOrEmpty("values", values);
-
-		switch(storageType)
-		{
-		case StorageType::Char:
-			return Marshal(values);
-		case StorageType::Double:
-			return MarshalStorageType<double>(values);
-		case StorageType::Float:
-			return MarshalStorageType<float>(values);
-		case StorageType::Integer:
-			return MarshalStorageType<int>(values);
-		case StorageType::Long:
-			return MarshalStorageType<long>(values);
-		case StorageType::Short:
-			return MarshalStorageType<short>(values);
-		default:
-			throw gcnew NotImplementedException();
-		}
-	}
-	//==============================================================================================
 	double* Marshaller::Marshal(array<double>^ values)
 	{
 		if (values == nullptr || values->Length == 0)
@@ -158,5 +126,26 @@ namespace GraphicsMagick
 		return unmanagedValue;
 	}
 	//==============================================================================================
+	int Marshaller::SizeOf(StorageType storageType)
+	{
+		switch (storageType)
+		{
+		case StorageType::Char:
+			return sizeof(unsigned char);
+		case StorageType::Double:
+			return sizeof(double);
+		case  StorageType::Float:
+			return sizeof(float);
+		case StorageType::Integer:
+			return sizeof(int);
+		case StorageType::Long:
+			return sizeof(long);
+		case StorageType::Short:
+			return sizeof(short);
+		default:
+			throw gcnew NotImplementedException();
+		}
+	}
+	//==============================================================================================
 #pragma warning(default: 6001)
 }
\ No newline at end of file
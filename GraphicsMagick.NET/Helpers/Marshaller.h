@@ -20,19 +20,12 @@ namespace GraphicsMagick
 	//==============================================================================================
 	private ref class Marshaller abstract sealed
 	{
-	private:
-		//===========================================================================================
-		template <typename TStorageType>
-		static TStorageType* MarshalStorageType(array<Byte>^ bytes);
-		//===========================================================================================
 	public:
 		//===========================================================================================
 		static unsigned char* Marshal(array<Byte>^ bytes);
 		//===========================================================================================
 		static void Marshal(array<Byte>^ bytes, Magick::Blob* value);
 		//===========================================================================================
-		static void* Marshal(array<Byte>^ bytes, StorageType storageType);
-		//===========================================================================================
 		static double* Marshal(array<double>^ values);
 		//===========================================================================================
 		static array<Byte>^ Marshal(Magick::Blob* value);
@@ -45,6 +38,8 @@ namespace GraphicsMagick
 		//===========================================================================================
 		static double* MarshalAndTerminate(array<double>^ values);
 		//===========================================================================================
+		static int SizeOf(StorageType storageType);
+		//===========================================================================================
 	};
 	//==============================================================================================
 }
\ No newline at end of file
@@ -0,0 +1,46 @@
+//=================================================================================================
+// Copyright 2014-2015 Dirk Lemstra <https://graphicsmagick.codeplex.com/>
+//
+// Licensed under the ImageMagick License (the "License"); you may not use this file except in 
+// compliance with the License. You may obtain a copy of the License at
+//
+//   http://www.imagemagick.org/script/license.php
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the
+// License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing permissions and
+// limitations under the License.
+//=================================================================================================
+#include "Stdafx.h"
+#include "SimdHelper.h"
+#include <intrin.h>
+
+#pragma managed(push, off)
+namespace
+{
+	//==============================================================================================
+	bool HasSse2()
+	{
+		// Bit 26 of EDX of the processor info and feature bits is set when SSE2 is supported.
+		int info[4];
+		__cpuid(info, 1);
+		return (info[3] & (1 << 26)) != 0;
+	}
+	//==============================================================================================
+}
+#pragma managed(pop)
+
+namespace GraphicsMagick
+{
+	//==============================================================================================
+	bool SimdHelper::DetectSse2()
+	{
+		return HasSse2();
+	}
+	//==============================================================================================
+	bool SimdHelper::IsSse2Supported()
+	{
+		return _IsSse2Supported;
+	}
+	//==============================================================================================
+}
\ No newline at end of file
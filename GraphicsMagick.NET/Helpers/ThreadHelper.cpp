@@ -0,0 +1,34 @@
+//=================================================================================================
+// Copyright 2014-2015 Dirk Lemstra <https://graphicsmagick.codeplex.com/>
+//
+// Licensed under the ImageMagick License (the "License"); you may not use this file except in 
+// compliance with the License. You may obtain a copy of the License at
+//
+//   http://www.imagemagick.org/script/license.php
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the
+// License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing permissions and
+// limitations under the License.
+//=================================================================================================
+#include "Stdafx.h"
+#include "ThreadHelper.h"
+#include <windows.h>
+
+namespace GraphicsMagick
+{
+	//==============================================================================================
+	TimeSpan ThreadHelper::GetProcessorTime()
+	{
+		FILETIME creationTime, exitTime, kernelTime, userTime;
+		if (!GetThreadTimes(GetCurrentThread(), &creationTime, &exitTime, &kernelTime, &userTime))
+			return TimeSpan::Zero;
+
+		// The times are in units of 100 nanoseconds, the same unit as the ticks of a TimeSpan.
+		Int64 kernel = ((Int64)kernelTime.dwHighDateTime << 32) | kernelTime.dwLowDateTime;
+		Int64 user = ((Int64)userTime.dwHighDateTime << 32) | userTime.dwLowDateTime;
+
+		return TimeSpan(kernel + user);
+	}
+	//==============================================================================================
+}
\ No newline at end of file
@@ -12,6 +12,7 @@
 // limitations under the License.
 //=================================================================================================
 #include "Stdafx.h"
+#include "FileHelper.h"
 
 using namespace System::IO;
 using namespace System::Globalization;
@@ -37,32 +38,10 @@ namespace GraphicsMagick
 	{
 		Throw::IfNullOrEmpty("fileName", fileName);
 
-		if (fileName->Length > 248)
+		String^ path = FileHelper::GetFilePath(fileName);
+		if (path == nullptr)
 			return;
 
-		String^ path = fileName;
-
-		int colonIndex = fileName->IndexOf(':');
-		if (colonIndex != -1)
-		{
-			if (colonIndex + 1 == fileName->Length)
-				return;
-
-			if (!fileName->Contains("\\"))
-				return;
-
-			if (fileName[colonIndex + 1] != '/' && fileName[colonIndex + 1] != '\\')
-				path = path->Substring(colonIndex + 1);
-		}
-
-		path = Path::GetFullPath(path);
-		if (path->EndsWith("]", StringComparison::OrdinalIgnoreCase))
-		{
-			int endIndex = path->IndexOf("[", StringComparison::OrdinalIgnoreCase);
-			if (endIndex != -1)
-				path = path->Substring(0, endIndex);
-		}
-
 		Throw::IfFalse("fileName", File::Exists(path), "Unable to find file: {0}", path);
 	}
 	//==============================================================================================
@@ -0,0 +1,386 @@
+//=================================================================================================
+// Copyright 2014-2015 Dirk Lemstra <https://graphicsmagick.codeplex.com/>
+//
+// Licensed under the ImageMagick License (the "License"); you may not use this file except in 
+// compliance with the License. You may obtain a copy of the License at
+//
+//   http://www.imagemagick.org/script/license.php
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the
+// License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing permissions and
+// limitations under the License.
+//=================================================================================================
+#include "Stdafx.h"
+#include "SimdHelper.h"
+#include "YuvConverter.h"
+#include <emmintrin.h>
+
+// The conversion loops are compiled as native code with fixed-point BT.601 coefficients. The
+// pixels are first split into planar 8-bit channels so the export can convert sixteen pixels at a
+// time with SSE2, the managed methods below only walk the pixel cache.
+#pragma managed(push, off)
+namespace
+{
+	using MagickLib::Quantum;
+	//==============================================================================================
+	inline unsigned char ClampToByte(int value)
+	{
+		return (unsigned char)(value < 0 ? 0 : (value > 255 ? 255 : value));
+	}
+	//==============================================================================================
+	inline unsigned char ToY(int r, int g, int b)
+	{
+		return (unsigned char)(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+	}
+	//==============================================================================================
+	inline unsigned char ToU(int r, int g, int b)
+	{
+		return (unsigned char)(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+	}
+	//==============================================================================================
+	inline unsigned char ToV(int r, int g, int b)
+	{
+		return (unsigned char)(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+	}
+	//==============================================================================================
+	inline void ToPixel(int y, int u, int v, MagickLib::PixelPacket* pixel)
+	{
+		int c = 298 * (y - 16) + 128;
+		int d = u - 128;
+		int e = v - 128;
+
+		pixel->red = ScaleCharToQuantum(ClampToByte((c + 409 * e) >> 8));
+		pixel->green = ScaleCharToQuantum(ClampToByte((c - 100 * d - 208 * e) >> 8));
+		pixel->blue = ScaleCharToQuantum(ClampToByte((c + 516 * d) >> 8));
+		pixel->opacity = OpaqueOpacity;
+	}
+	//==============================================================================================
+	inline __m128i ToY(__m128i r, __m128i g, __m128i b)
+	{
+		// The sum fits in an unsigned 16-bit value so a logical shift gives the same result as
+		// the scalar code.
+		__m128i sum = _mm_add_epi16(_mm_mullo_epi16(r, _mm_set1_epi16(66)), _mm_mullo_epi16(g, _mm_set1_epi16(129)));
+		sum = _mm_add_epi16(sum, _mm_add_epi16(_mm_mullo_epi16(b, _mm_set1_epi16(25)), _mm_set1_epi16(128)));
+		return _mm_add_epi16(_mm_srli_epi16(sum, 8), _mm_set1_epi16(16));
+	}
+	//==============================================================================================
+	inline __m128i ToU(__m128i r, __m128i g, __m128i b)
+	{
+		__m128i sum = _mm_add_epi16(_mm_mullo_epi16(r, _mm_set1_epi16(-38)), _mm_mullo_epi16(g, _mm_set1_epi16(-74)));
+		sum = _mm_add_epi16(sum, _mm_add_epi16(_mm_mullo_epi16(b, _mm_set1_epi16(112)), _mm_set1_epi16(128)));
+		return _mm_add_epi16(_mm_srai_epi16(sum, 8), _mm_set1_epi16(128));
+	}
+	//==============================================================================================
+	inline __m128i ToV(__m128i r, __m128i g, __m128i b)
+	{
+		__m128i sum = _mm_add_epi16(_mm_mullo_epi16(r, _mm_set1_epi16(112)), _mm_mullo_epi16(g, _mm_set1_epi16(-94)));
+		sum = _mm_add_epi16(sum, _mm_add_epi16(_mm_mullo_epi16(b, _mm_set1_epi16(-18)), _mm_set1_epi16(128)));
+		return _mm_add_epi16(_mm_srai_epi16(sum, 8), _mm_set1_epi16(128));
+	}
+	//==============================================================================================
+	inline __m128i AddPairs(__m128i first, __m128i second)
+	{
+		// Adds the neighbouring values of sixteen 16-bit values and returns the eight sums.
+		__m128i ones = _mm_set1_epi16(1);
+		return _mm_packs_epi32(_mm_madd_epi16(first, ones), _mm_madd_epi16(second, ones));
+	}
+	//==============================================================================================
+	inline __m128i Load(const short* values)
+	{
+		return _mm_loadu_si128((const __m128i*)values);
+	}
+	//==============================================================================================
+	void ToPlanar(const MagickLib::PixelPacket* pixels, int count, short* red, short* green,
+		short* blue)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			red[i] = ScaleQuantumToChar(pixels[i].red);
+			green[i] = ScaleQuantumToChar(pixels[i].green);
+			blue[i] = ScaleQuantumToChar(pixels[i].blue);
+		}
+	}
+	//==============================================================================================
+	int ExportRowsSse2(const short* red, const short* green, const short* blue, int width,
+		unsigned char* yTop, unsigned char* yBottom, unsigned char* u, unsigned char* v,
+		bool isInterleaved)
+	{
+		int x = 0;
+		for (; x + 16 <= width; x += 16)
+		{
+			__m128i r0 = Load(red + x), r1 = Load(red + x + 8);
+			__m128i r2 = Load(red + width + x), r3 = Load(red + width + x + 8);
+			__m128i g0 = Load(green + x), g1 = Load(green + x + 8);
+			__m128i g2 = Load(green + width + x), g3 = Load(green + width + x + 8);
+			__m128i b0 = Load(blue + x), b1 = Load(blue + x + 8);
+			__m128i b2 = Load(blue + width + x), b3 = Load(blue + width + x + 8);
+
+			_mm_storeu_si128((__m128i*)(yTop + x), _mm_packus_epi16(ToY(r0, g0, b0), ToY(r1, g1, b1)));
+			_mm_storeu_si128((__m128i*)(yBottom + x), _mm_packus_epi16(ToY(r2, g2, b2), ToY(r3, g3, b3)));
+
+			__m128i two = _mm_set1_epi16(2);
+			__m128i r = _mm_srli_epi16(_mm_add_epi16(AddPairs(_mm_add_epi16(r0, r2), _mm_add_epi16(r1, r3)), two), 2);
+			__m128i g = _mm_srli_epi16(_mm_add_epi16(AddPairs(_mm_add_epi16(g0, g2), _mm_add_epi16(g1, g3)), two), 2);
+			__m128i b = _mm_srli_epi16(_mm_add_epi16(AddPairs(_mm_add_epi16(b0, b2), _mm_add_epi16(b1, b3)), two), 2);
+
+			// The low eight bytes contain U and the high eight bytes contain V.
+			__m128i chroma = _mm_packus_epi16(ToU(r, g, b), ToV(r, g, b));
+			if (isInterleaved)
+			{
+				_mm_storeu_si128((__m128i*)(u + x), _mm_unpacklo_epi8(chroma, _mm_srli_si128(chroma, 8)));
+			}
+			else
+			{
+				_mm_storel_epi64((__m128i*)(u + x / 2), chroma);
+				_mm_storel_epi64((__m128i*)(v + x / 2), _mm_srli_si128(chroma, 8));
+			}
+		}
+
+		return x;
+	}
+	//==============================================================================================
+	void ExportRows(const short* red, const short* green, const short* blue, int width, int start,
+		unsigned char* yTop, unsigned char* yBottom, unsigned char* u, unsigned char* v,
+		int chromaStep)
+	{
+		for (int x = start; x < width; x += 2)
+		{
+			int r0 = red[x], g0 = green[x], b0 = blue[x];
+			int r1 = red[x + 1], g1 = green[x + 1], b1 = blue[x + 1];
+			int r2 = red[width + x], g2 = green[width + x], b2 = blue[width + x];
+			int r3 = red[width + x + 1], g3 = green[width + x + 1], b3 = blue[width + x + 1];
+
+			yTop[x] = ToY(r0, g0, b0);
+			yTop[x + 1] = ToY(r1, g1, b1);
+			yBottom[x] = ToY(r2, g2, b2);
+			yBottom[x + 1] = ToY(r3, g3, b3);
+
+			int r = (r0 + r1 + r2 + r3 + 2) >> 2;
+			int g = (g0 + g1 + g2 + g3 + 2) >> 2;
+			int b = (b0 + b1 + b2 + b3 + 2) >> 2;
+
+			int offset = x / 2 * chromaStep;
+			u[offset] = ToU(r, g, b);
+			v[offset] = ToV(r, g, b);
+		}
+	}
+	//==============================================================================================
+	void ExportRows(const MagickLib::PixelPacket* pixels, int width, short* planar, bool useSse2,
+		unsigned char* yTop, unsigned char* yBottom, unsigned char* u, unsigned char* v,
+		int chromaStep)
+	{
+		short* red = planar;
+		short* green = planar + (2 * width);
+		short* blue = planar + (4 * width);
+		ToPlanar(pixels, 2 * width, red, green, blue);
+
+		int start = 0;
+		if (useSse2)
+			start = ExportRowsSse2(red, green, blue, width, yTop, yBottom, u, v, chromaStep == 2);
+
+		ExportRows(red, green, blue, width, start, yTop, yBottom, u, v, chromaStep);
+	}
+	//==============================================================================================
+	int ExportPackedRowSse2(const short* red, const short* green, const short* blue, int width,
+		unsigned char* yuyv)
+	{
+		int x = 0;
+		for (; x + 16 <= width; x += 16)
+		{
+			__m128i r0 = Load(red + x), r1 = Load(red + x + 8);
+			__m128i g0 = Load(green + x), g1 = Load(green + x + 8);
+			__m128i b0 = Load(blue + x), b1 = Load(blue + x + 8);
+
+			__m128i y = _mm_packus_epi16(ToY(r0, g0, b0), ToY(r1, g1, b1));
+
+			__m128i one = _mm_set1_epi16(1);
+			__m128i r = _mm_srli_epi16(_mm_add_epi16(AddPairs(r0, r1), one), 1);
+			__m128i g = _mm_srli_epi16(_mm_add_epi16(AddPairs(g0, g1), one), 1);
+			__m128i b = _mm_srli_epi16(_mm_add_epi16(AddPairs(b0, b1), one), 1);
+
+			__m128i chroma = _mm_packus_epi16(ToU(r, g, b), ToV(r, g, b));
+			chroma = _mm_unpacklo_epi8(chroma, _mm_srli_si128(chroma, 8));
+
+			_mm_storeu_si128((__m128i*)(yuyv + (x * 2)), _mm_unpacklo_epi8(y, chroma));
+			_mm_storeu_si128((__m128i*)(yuyv + (x * 2) + 16), _mm_unpackhi_epi8(y, chroma));
+		}
+
+		return x;
+	}
+	//==============================================================================================
+	void ExportPackedRow(const MagickLib::PixelPacket* pixels, int width, short* planar,
+		bool useSse2, unsigned char* yuyv)
+	{
+		short* red = planar;
+		short* green = planar + width;
+		short* blue = planar + (2 * width);
+		ToPlanar(pixels, width, red, green, blue);
+
+		int start = 0;
+		if (useSse2)
+			start = ExportPackedRowSse2(red, green, blue, width, yuyv);
+
+		for (int x = start; x < width; x += 2)
+		{
+			int r0 = red[x], g0 = green[x], b0 = blue[x];
+			int r1 = red[x + 1], g1 = green[x + 1], b1 = blue[x + 1];
+
+			int r = (r0 + r1 + 1) >> 1;
+			int g = (g0 + g1 + 1) >> 1;
+			int b = (b0 + b1 + 1) >> 1;
+
+			unsigned char* pixel = yuyv + (x * 2);
+			pixel[0] = ToY(r0, g0, b0);
+			pixel[1] = ToU(r, g, b);
+			pixel[2] = ToY(r1, g1, b1);
+			pixel[3] = ToV(r, g, b);
+		}
+	}
+	//==============================================================================================
+	void ImportRows(const unsigned char* yTop, const unsigned char* yBottom, const unsigned char* u,
+		const unsigned char* v, int chromaStep, int width, MagickLib::PixelPacket* top,
+		MagickLib::PixelPacket* bottom)
+	{
+		for (int x = 0; x < width; x += 2)
+		{
+			ToPixel(yTop[x], *u, *v, top + x);
+			ToPixel(yTop[x + 1], *u, *v, top + x + 1);
+			ToPixel(yBottom[x], *u, *v, bottom + x);
+			ToPixel(yBottom[x + 1], *u, *v, bottom + x + 1);
+
+			u += chromaStep;
+			v += chromaStep;
+		}
+	}
+	//==============================================================================================
+	void ImportPackedRow(const unsigned char* yuyv, int width, MagickLib::PixelPacket* row)
+	{
+		for (int x = 0; x < width; x += 2)
+		{
+			ToPixel(yuyv[0], yuyv[1], yuyv[3], row + x);
+			ToPixel(yuyv[2], yuyv[1], yuyv[3], row + x + 1);
+			yuyv += 4;
+		}
+	}
+	//==============================================================================================
+}
+#pragma managed(pop)
+
+namespace GraphicsMagick
+{
+	//==============================================================================================
+	bool YuvConverter::Export(const MagickLib::Image* image, YuvFormat format,
+		unsigned char* destination, MagickLib::ExceptionInfo* exceptionInfo)
+	{
+		int width = (int)image->columns;
+		int height = (int)image->rows;
+		GetLength(width, height, format);
+
+		bool useSse2 = SimdHelper::IsSse2Supported();
+		short* planar = new short[6 * width];
+		try
+		{
+			if (format == YuvFormat::YUY2)
+			{
+				for (int y = 0; y < height; y++)
+				{
+					const MagickLib::PixelPacket* p = MagickLib::AcquireImagePixels(image, 0, y, width, 1, exceptionInfo);
+					if (p == NULL)
+						return false;
+
+					ExportPackedRow(p, width, planar, useSse2, destination + (y * width * 2));
+				}
+
+				return true;
+			}
+
+			unsigned char* u = destination + (width * height);
+			unsigned char* v = format == YuvFormat::NV12 ? u + 1 : u + (width * height / 4);
+			int chromaStep = format == YuvFormat::NV12 ? 2 : 1;
+			int chromaStride = width / 2 * chromaStep;
+
+			for (int y = 0; y < height; y += 2)
+			{
+				const MagickLib::PixelPacket* p = MagickLib::AcquireImagePixels(image, 0, y, width, 2, exceptionInfo);
+				if (p == NULL)
+					return false;
+
+				unsigned char* yTop = destination + (y * width);
+				int chromaOffset = y / 2 * chromaStride;
+				ExportRows(p, width, planar, useSse2, yTop, yTop + width, u + chromaOffset, v + chromaOffset, chromaStep);
+			}
+
+			return true;
+		}
+		finally
+		{
+			delete[] planar;
+		}
+	}
+	//==============================================================================================
+	int YuvConverter::GetLength(int width, int height, YuvFormat format)
+	{
+		Throw::IfTrue("width", width < 2 || width % 2 != 0, "The width should be a multiple of 2.");
+
+		switch (format)
+		{
+		case YuvFormat::I420:
+		case YuvFormat::NV12:
+			Throw::IfTrue("height", height < 2 || height % 2 != 0, "The height should be a multiple of 2.");
+			return width * height * 3 / 2;
+		case YuvFormat::YUY2:
+			Throw::IfTrue("height", height < 1, "The height should be at least 1.");
+			return width * height * 2;
+		default:
+			throw gcnew NotImplementedException();
+		}
+	}
+	//==============================================================================================
+	MagickLib::Image* YuvConverter::Import(const unsigned char* data, int width, int height,
+		YuvFormat format, MagickLib::ExceptionInfo* exceptionInfo)
+	{
+		GetLength(width, height, format);
+
+		MagickLib::Image* image = MagickLib::AllocateImage((MagickLib::ImageInfo*) NULL);
+		image->columns = width;
+		image->rows = height;
+
+		int rows = format == YuvFormat::YUY2 ? 1 : 2;
+		const unsigned char* u = data + (width * height);
+		const unsigned char* v = format == YuvFormat::NV12 ? u + 1 : u + (width * height / 4);
+		int chromaStep = format == YuvFormat::NV12 ? 2 : 1;
+		int chromaStride = width / 2 * chromaStep;
+
+		for (int y = 0; y < height; y += rows)
+		{
+			MagickLib::PixelPacket* q = MagickLib::SetImagePixels(image, 0, y, width, rows);
+			if (q == NULL)
+				break;
+
+			if (format == YuvFormat::YUY2)
+			{
+				ImportPackedRow(data + (y * width * 2), width, q);
+			}
+			else
+			{
+				const unsigned char* yTop = data + (y * width);
+				int chromaOffset = y / 2 * chromaStride;
+				ImportRows(yTop, yTop + width, u + chromaOffset, v + chromaOffset, chromaStep, width, q, q + width);
+			}
+
+			if (!MagickLib::SyncImagePixels(image))
+				break;
+		}
+
+		if (image->exception.severity != MagickLib::UndefinedException)
+		{
+			MagickLib::CopyException(exceptionInfo, &image->exception);
+			MagickLib::DestroyImage(image);
+			return NULL;
+		}
+
+		return image;
+	}
+	//==============================================================================================
+}
\ No newline at end of file
@@ -0,0 +1,35 @@
+//=================================================================================================
+// Copyright 2014-2015 Dirk Lemstra <https://graphicsmagick.codeplex.com/>
+//
+// Licensed under the ImageMagick License (the "License"); you may not use this file except in 
+// compliance with the License. You may obtain a copy of the License at
+//
+//   http://www.imagemagick.org/script/license.php
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the
+// License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing permissions and
+// limitations under the License.
+//=================================================================================================
+#pragma once
+
+#include "..\Enums\YuvFormat.h"
+
+namespace GraphicsMagick
+{
+	//==============================================================================================
+	private ref class YuvConverter abstract sealed
+	{
+	public:
+		//===========================================================================================
+		static bool Export(const MagickLib::Image* image, YuvFormat format, unsigned char* destination,
+			MagickLib::ExceptionInfo* exceptionInfo);
+		//===========================================================================================
+		static int GetLength(int width, int height, YuvFormat format);
+		//===========================================================================================
+		static MagickLib::Image* Import(const unsigned char* data, int width, int height,
+			YuvFormat format, MagickLib::ExceptionInfo* exceptionInfo);
+		//===========================================================================================
+	};
+	//==============================================================================================
+}
\ No newline at end of file
@@ -0,0 +1,169 @@
+//=================================================================================================
+// Copyright 2014-2015 Dirk Lemstra <https://graphicsmagick.codeplex.com/>
+//
+// Licensed under the ImageMagick License (the "License"); you may not use this file except in 
+// compliance with the License. You may obtain a copy of the License at
+//
+//   http://www.imagemagick.org/script/license.php
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the
+// License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing permissions and
+// limitations under the License.
+//=================================================================================================
+#include "Stdafx.h"
+#include "..\Helpers\FileHelper.h"
+#include "DecodedCache.h"
+
+using namespace System::Security::Cryptography;
+using namespace System::Text;
+
+namespace GraphicsMagick
+{
+	// The MPC coder stores the pixels in a separate .cache file that is memory-mapped when the
+	// image is read, the format of the original image is kept in this attribute.
+	static const char* FormatAttribute = "decoded-cache:format";
+	//==============================================================================================
+	String^ DecodedCache::GetFileName(String^ filePath, String^ sourcePath, MagickReadSettings^ readSettings)
+	{
+		Throw::IfTrue("readSettings", String::IsNullOrEmpty(readSettings->DecodedCacheDirectory),
+			"The decoded cache directory should be set when the decoded cache is used.");
+
+		// The file name is also part of the key because the format prefix and the frame suffix
+		// change the image that is read from the file.
+		String^ key = sourcePath->ToUpperInvariant() + "|" + filePath + "|" + readSettings->ToString();
+
+		MD5^ md5 = MD5::Create();
+		try
+		{
+			array<Byte>^ hash = md5->ComputeHash(Encoding::UTF8->GetBytes(key));
+			return Path::Combine(readSettings->DecodedCacheDirectory, BitConverter::ToString(hash)->Replace("-", "") + ".mpc");
+		}
+		finally
+		{
+			delete md5;
+		}
+	}
+	//==============================================================================================
+	String^ DecodedCache::GetPixelCacheFileName(String^ fileName)
+	{
+		return Path::ChangeExtension(fileName, ".cache");
+	}
+	//==============================================================================================
+	bool DecodedCache::IsCurrent(String^ fileName, String^ sourcePath)
+	{
+		if (!File::Exists(fileName) || !File::Exists(GetPixelCacheFileName(fileName)))
+			return false;
+
+		return File::GetLastWriteTimeUtc(fileName) >= File::GetLastWriteTimeUtc(sourcePath);
+	}
+	//==============================================================================================
+	MagickException^ DecodedCache::Read(Magick::Image* image, String^ fileName)
+	{
+		String^ filePath = FileHelper::CheckForBaseDirectory(fileName);
+		Throw::IfInvalidFileName(filePath);
+
+		std::string imageSpec;
+		Marshaller::Marshal("MPC:" + filePath, imageSpec);
+
+		try
+		{
+			image->read(imageSpec);
+
+			const MagickLib::ImageAttribute* attribute = MagickLib::GetImageAttribute(image->image(), FormatAttribute);
+			if (attribute != NULL)
+			{
+				image->magick(attribute->value);
+				(void) MagickLib::SetImageAttribute(image->image(), FormatAttribute, (char *) NULL);
+			}
+
+			return nullptr;
+		}
+		catch (Magick::Exception& exception)
+		{
+			return MagickException::Create(exception);
+		}
+	}
+	//==============================================================================================
+	bool DecodedCache::TryRead(Magick::Image* image, String^ filePath, MagickReadSettings^ readSettings)
+	{
+		if (readSettings->DecodedCachePolicy == DecodedCachePolicy::Disabled)
+			return false;
+
+		String^ sourcePath = FileHelper::GetFilePath(filePath);
+		if (sourcePath == nullptr)
+			return false;
+
+		String^ fileName = GetFileName(filePath, sourcePath, readSettings);
+		if (!IsCurrent(fileName, sourcePath))
+			return false;
+
+		// A cache that cannot be read is ignored, the file will be decoded and the cache rewritten.
+		return Read(image, fileName) == nullptr;
+	}
+	//==============================================================================================
+	void DecodedCache::TryWrite(Magick::Image* image, String^ filePath, MagickReadSettings^ readSettings)
+	{
+		if (readSettings->DecodedCachePolicy != DecodedCachePolicy::ReadWrite)
+			return;
+
+		String^ sourcePath = FileHelper::GetFilePath(filePath);
+		if (sourcePath == nullptr)
+			return;
+
+		String^ fileName = GetFileName(filePath, sourcePath, readSettings);
+		String^ tempFileName = fileName + "." + Guid::NewGuid().ToString("N") + ".mpc";
+
+		try
+		{
+			Directory::CreateDirectory(readSettings->DecodedCacheDirectory);
+
+			if (Write(image, tempFileName) != nullptr)
+				return;
+
+			// The pixels are moved first so a reader never finds a header without its pixels.
+			File::Delete(fileName);
+			File::Delete(GetPixelCacheFileName(fileName));
+			File::Move(GetPixelCacheFileName(tempFileName), GetPixelCacheFileName(fileName));
+			File::Move(tempFileName, fileName);
+		}
+		catch (IOException^)
+		{
+		}
+		catch (UnauthorizedAccessException^)
+		{
+		}
+		finally
+		{
+			if (File::Exists(tempFileName))
+				File::Delete(tempFileName);
+			if (File::Exists(GetPixelCacheFileName(tempFileName)))
+				File::Delete(GetPixelCacheFileName(tempFileName));
+		}
+	}
+	//==============================================================================================
+	MagickException^ DecodedCache::Write(Magick::Image* image, String^ fileName)
+	{
+		Throw::IfNullOrEmpty("fileName", fileName);
+		String^ filePath = FileHelper::CheckForBaseDirectory(fileName);
+
+		std::string imageSpec;
+		Marshaller::Marshal("MPC:" + filePath, imageSpec);
+
+		// The copy shares the pixels with the image and makes sure the format of the image is
+		// not changed into MPC.
+		Magick::Image copy = *image;
+
+		try
+		{
+			copy.attribute(FormatAttribute, image->magick());
+			copy.write(imageSpec);
+			return nullptr;
+		}
+		catch (Magick::Exception& exception)
+		{
+			return MagickException::Create(exception);
+		}
+	}
+	//==============================================================================================
+}
\ No newline at end of file
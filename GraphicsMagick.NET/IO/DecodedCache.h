@@ -0,0 +1,47 @@
+//=================================================================================================
+// Copyright 2014-2015 Dirk Lemstra <https://graphicsmagick.codeplex.com/>
+//
+// Licensed under the ImageMagick License (the "License"); you may not use this file except in 
+// compliance with the License. You may obtain a copy of the License at
+//
+//   http://www.imagemagick.org/script/license.php
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the
+// License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing permissions and
+// limitations under the License.
+//=================================================================================================
+#pragma once
+
+#include "..\Exceptions\Base\MagickException.h"
+#include "..\Settings\MagickReadSettings.h"
+
+using namespace System::IO;
+
+namespace GraphicsMagick
+{
+	//==============================================================================================
+	private ref class DecodedCache abstract sealed
+	{
+		//===========================================================================================
+	private:
+		//===========================================================================================
+		static String^ GetFileName(String^ filePath, String^ sourcePath, MagickReadSettings^ readSettings);
+		//===========================================================================================
+		static String^ GetPixelCacheFileName(String^ fileName);
+		//===========================================================================================
+		static bool IsCurrent(String^ fileName, String^ sourcePath);
+		//===========================================================================================
+	internal:
+		//===========================================================================================
+		static MagickException^ Read(Magick::Image* image, String^ fileName);
+		//===========================================================================================
+		static bool TryRead(Magick::Image* image, String^ filePath, MagickReadSettings^ readSettings);
+		//===========================================================================================
+		static void TryWrite(Magick::Image* image, String^ filePath, MagickReadSettings^ readSettings);
+		//===========================================================================================
+		static MagickException^ Write(Magick::Image* image, String^ fileName);
+		//===========================================================================================
+	};
+	//==============================================================================================
+}
\ No newline at end of file
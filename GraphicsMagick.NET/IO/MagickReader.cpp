@@ -13,31 +13,201 @@
 //=================================================================================================
 #include "Stdafx.h"
 #include "..\Helpers\FileHelper.h"
+#include "..\Helpers\YuvConverter.h"
+#include "DecodedCache.h"
 #include "MagickReader.h"
 
+// The rows of a padded pixel buffer are converted by native code with the same scaling as
+// ConstituteImage, the managed method below only walks the pixel cache.
+#pragma managed(push, off)
+namespace
+{
+	using MagickLib::Quantum;
+	//==============================================================================================
+	inline Quantum ToQuantum(unsigned char value)
+	{
+		return ScaleCharToQuantum(value);
+	}
+	//==============================================================================================
+	inline Quantum ToQuantum(unsigned short value)
+	{
+		return ScaleShortToQuantum(value);
+	}
+	//==============================================================================================
+	inline Quantum ToQuantum(unsigned int value)
+	{
+		return ScaleLongToQuantum(value);
+	}
+	//==============================================================================================
+	inline Quantum ToQuantum(unsigned long value)
+	{
+		return ScaleLongToQuantum(value);
+	}
+	//==============================================================================================
+	inline Quantum ToQuantum(float value)
+	{
+		double scaled = MaxRGBDouble * value;
+		return RoundDoubleToQuantum(scaled);
+	}
+	//==============================================================================================
+	inline Quantum ToQuantum(double value)
+	{
+		double scaled = MaxRGBDouble * value;
+		return RoundDoubleToQuantum(scaled);
+	}
+	//==============================================================================================
+	template<typename TType>
+	void ImportRow(const TType* values, const char* map, int channels, int width,
+		MagickLib::PixelPacket* pixels, MagickLib::IndexPacket* indexes)
+	{
+		for (int x = 0; x < width; x++)
+		{
+			pixels[x].opacity = OpaqueOpacity;
+			for (int i = 0; i < channels; i++)
+			{
+				Quantum value = ToQuantum(*values++);
+				switch (map[i])
+				{
+				case 'R':
+				case 'C':
+					pixels[x].red = value;
+					break;
+				case 'G':
+				case 'M':
+					pixels[x].green = value;
+					break;
+				case 'B':
+				case 'Y':
+					pixels[x].blue = value;
+					break;
+				case 'K':
+					pixels[x].opacity = value;
+					break;
+				case 'A':
+					if (indexes != NULL)
+						indexes[x] = (Quantum)(MaxRGB - value);
+					else
+						pixels[x].opacity = (Quantum)(MaxRGB - value);
+					break;
+				case 'O':
+					if (indexes != NULL)
+						indexes[x] = value;
+					else
+						pixels[x].opacity = value;
+					break;
+				case 'I':
+					pixels[x].red = value;
+					pixels[x].green = value;
+					pixels[x].blue = value;
+					break;
+				}
+			}
+		}
+	}
+	//==============================================================================================
+	void ImportRow(const void* row, MagickLib::StorageType storageType, const char* map, int channels,
+		int width, MagickLib::PixelPacket* pixels, MagickLib::IndexPacket* indexes)
+	{
+		switch (storageType)
+		{
+		case MagickLib::CharPixel:
+			ImportRow((const unsigned char*)row, map, channels, width, pixels, indexes);
+			break;
+		case MagickLib::ShortPixel:
+			ImportRow((const unsigned short*)row, map, channels, width, pixels, indexes);
+			break;
+		case MagickLib::IntegerPixel:
+			ImportRow((const unsigned int*)row, map, channels, width, pixels, indexes);
+			break;
+		case MagickLib::LongPixel:
+			ImportRow((const unsigned long*)row, map, channels, width, pixels, indexes);
+			break;
+		case MagickLib::FloatPixel:
+			ImportRow((const float*)row, map, channels, width, pixels, indexes);
+			break;
+		case MagickLib::DoublePixel:
+			ImportRow((const double*)row, map, channels, width, pixels, indexes);
+			break;
+		}
+	}
+	//==============================================================================================
+}
+#pragma managed(pop)
+
 namespace GraphicsMagick
 {
 	//==============================================================================================
 	int MagickReader::GetExpectedLength(MagickReadSettings^ readSettings)
 	{
 		int length = readSettings->Width.Value * readSettings->Height.Value * readSettings->PixelStorage->Mapping->Length;
-		switch (readSettings->PixelStorage->StorageType)
+		return length * Marshaller::SizeOf(readSettings->PixelStorage->StorageType);
+	}
+	//==============================================================================================
+	void MagickReader::ReadPixels(Magick::Image* image, const void* data, int width, int height,
+		String^ map, StorageType storageType, int stride)
+	{
+		int rowSize = width * map->Length * Marshaller::SizeOf(storageType);
+		if (stride == rowSize)
+		{
+			std::string magickMap;
+			Marshaller::Marshal(map, magickMap);
+
+			image->read(width, height, magickMap, (MagickLib::StorageType)storageType, data);
+			return;
+		}
+
+		ReadRows(image, data, width, height, map->ToUpperInvariant(), storageType, stride);
+	}
+	//==============================================================================================
+	void MagickReader::ReadRows(Magick::Image* image, const void* data, int width, int height,
+		String^ map, StorageType storageType, int stride)
+	{
+		String^ channels = "ABCGIKMOPRY";
+		for each (Char channel in map)
+		{
+			Throw::IfTrue("map", channels->IndexOf(channel) == -1, "Invalid channel '{0}' in the map.",
+				channel);
+		}
+
+		std::string magickMap;
+		Marshaller::Marshal(map, magickMap);
+
+		// The rows are imported one by one straight into the pixel cache so the padding at the end
+		// of each row does not require a copy of the whole frame.
+		MagickLib::Image* pixelImage = MagickLib::AllocateImage((MagickLib::ImageInfo*) NULL);
+		pixelImage->columns = width;
+		pixelImage->rows = height;
+		if (map->IndexOfAny(gcnew array<Char> { 'C', 'M', 'Y', 'K' }) != -1)
+			pixelImage->colorspace = MagickLib::CMYKColorspace;
+		if (map->IndexOfAny(gcnew array<Char> { 'A', 'O' }) != -1)
+			pixelImage->matte = MagickTrue;
+
+		bool hasIndexes = pixelImage->colorspace == MagickLib::CMYKColorspace && pixelImage->matte;
+		const unsigned char* source = (const unsigned char*)data;
+		for (int y = 0; y < height; y++)
 		{
-		case StorageType::Char:
-			return length;
-		case StorageType::Double:
-			return length * sizeof(double);
-		case  StorageType::Float:
-			return length * sizeof(float);
-		case StorageType::Integer:
-			return length * sizeof(int);
-		case StorageType::Long:
-			return length * sizeof(long);
-		case StorageType::Short:
-			return length * sizeof(short);
-		default:
-			throw gcnew NotImplementedException();
+			MagickLib::PixelPacket* pixels = MagickLib::SetImagePixels(pixelImage, 0, y, width, 1);
+			if (pixels == NULL)
+				break;
+
+			MagickLib::IndexPacket* indexes = hasIndexes ? MagickLib::AccessMutableIndexes(pixelImage) : NULL;
+			ImportRow(source + ((size_t)y * stride), (MagickLib::StorageType)storageType, magickMap.c_str(),
+				map->Length, width, pixels, indexes);
+
+			if (!MagickLib::SyncImagePixels(pixelImage))
+				break;
+		}
+
+		if (pixelImage->exception.severity != MagickLib::UndefinedException)
+		{
+			MagickLib::ExceptionInfo exceptionInfo;
+			MagickLib::GetExceptionInfo(&exceptionInfo);
+			MagickLib::CopyException(&exceptionInfo, &pixelImage->exception);
+			MagickLib::DestroyImage(pixelImage);
+			Magick::throwException(exceptionInfo);
 		}
+
+		image->replaceImage(pixelImage);
 	}
 	//==============================================================================================
 	void MagickReader::ReadPixels(Magick::Image* image, MagickReadSettings^ readSettings,
@@ -50,22 +220,12 @@ namespace GraphicsMagick
 		int length = GetExpectedLength(readSettings);
 		Throw::IfTrue("pixels", pixels->Length != length, "The array length is " + pixels->Length + " but should be " + length + ".");
 
-		void* convertedPixels = NULL;
-		try
-		{
-			convertedPixels = Marshaller::Marshal(pixels, readSettings->PixelStorage->StorageType);
-
-			std::string map;
-			Marshaller::Marshal(readSettings->PixelStorage->Mapping, map);
+		int width = readSettings->Width.Value;
+		int stride = length / readSettings->Height.Value;
 
-			Magick::Geometry size = Magick::Geometry();
-			image->read(readSettings->Width.Value, readSettings->Height.Value, map,
-				(MagickLib::StorageType)readSettings->PixelStorage->StorageType, convertedPixels);
-		}
-		finally
-		{
-			delete[] convertedPixels;
-		}
+		pin_ptr<Byte> data = &pixels[0];
+		ReadPixels(image, data, width, readSettings->Height.Value, readSettings->PixelStorage->Mapping,
+			readSettings->PixelStorage->StorageType, stride);
 	}
 	//==============================================================================================
 	array<Byte>^ MagickReader::ReadUnchecked(String^ filePath)
@@ -114,6 +274,52 @@ namespace GraphicsMagick
 		}
 	}
 	//==============================================================================================
+	MagickException^ MagickReader::Read(Magick::Image* image, IntPtr data, int width, int height,
+		String^ map, StorageType storageType, int stride)
+	{
+		Throw::IfTrue("data", data == IntPtr::Zero, "The pointer to the pixels cannot be zero.");
+		Throw::IfTrue("width", width < 1, "The width should be at least 1.");
+		Throw::IfTrue("height", height < 1, "The height should be at least 1.");
+		Throw::IfNullOrEmpty("map", map);
+
+		int pixelSize = map->Length * Marshaller::SizeOf(storageType);
+		Throw::IfTrue("stride", stride < width * pixelSize, "The stride should be at least {0}.", width * pixelSize);
+
+		try
+		{
+			ReadPixels(image, data.ToPointer(), width, height, map, storageType, stride);
+			return nullptr;
+		}
+		catch (Magick::Exception& exception)
+		{
+			return MagickException::Create(exception);
+		}
+	}
+	//==============================================================================================
+	MagickException^ MagickReader::Read(Magick::Image* image, IntPtr data, int width, int height,
+		YuvFormat format)
+	{
+		Throw::IfTrue("data", data == IntPtr::Zero, "The pointer to the pixels cannot be zero.");
+
+		MagickLib::ExceptionInfo exceptionInfo;
+		MagickLib::GetExceptionInfo(&exceptionInfo);
+
+		try
+		{
+			MagickLib::Image* yuvImage = YuvConverter::Import((const unsigned char*)data.ToPointer(),
+				width, height, format, &exceptionInfo);
+			Magick::throwException(exceptionInfo);
+			MagickLib::DestroyExceptionInfo(&exceptionInfo);
+
+			image->replaceImage(yuvImage);
+			return nullptr;
+		}
+		catch (Magick::Exception& exception)
+		{
+			return MagickException::Create(exception);
+		}
+	}
+	//==============================================================================================
 	MagickException^ MagickReader::Read(Magick::Image* image, MagickColor^ color, int width, int height)
 	{
 		Throw::IfNull("color", color);
@@ -194,12 +400,19 @@ namespace GraphicsMagick
 					ReadPixels(image, readSettings, bytes);
 					return nullptr;
 				}
+				else if (DecodedCache::TryRead(image, filePath, readSettings))
+				{
+					return nullptr;
+				}
 
 				readSettings->Apply(image);
 			}
 
 			image->read(imageSpec);
 
+			if (readSettings != nullptr)
+				DecodedCache::TryWrite(image, filePath, readSettings);
+
 			return nullptr;
 		}
 		catch (Magick::Exception& exception)
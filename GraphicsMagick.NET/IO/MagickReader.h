@@ -13,6 +13,7 @@
 //=================================================================================================
 #pragma once
 
+#include "..\Enums\YuvFormat.h"
 #include "..\Exceptions\Base\MagickException.h"
 #include "..\Exceptions\MagickWarningExceptions.h"
 #include "..\MagickImage.h"
@@ -34,9 +35,15 @@ namespace GraphicsMagick
 		//===========================================================================================
 		static int GetExpectedLength(MagickReadSettings^ readSettings);
 		//===========================================================================================
+		static void ReadPixels(Magick::Image* image, const void* data, int width, int height,
+			String^ map, StorageType storageType, int stride);
+		//===========================================================================================
 		static void ReadPixels(Magick::Image* image, MagickReadSettings^ readSettings,
 			array<Byte>^ pixels);
 		//===========================================================================================
+		static void ReadRows(Magick::Image* image, const void* data, int width, int height,
+			String^ map, StorageType storageType, int stride);
+		//===========================================================================================
 		static array<Byte>^ ReadUnchecked(String^ filePath);
 		//===========================================================================================
 	internal:
@@ -44,6 +51,12 @@ namespace GraphicsMagick
 		static MagickException^ Read(Magick::Image* image, array<Byte>^ bytes,
 			MagickReadSettings^ readSettings);
 		//===========================================================================================
+		static MagickException^ Read(Magick::Image* image, IntPtr data, int width, int height,
+			String^ map, StorageType storageType, int stride);
+		//===========================================================================================
+		static MagickException^ Read(Magick::Image* image, IntPtr data, int width, int height,
+			YuvFormat format);
+		//===========================================================================================
 		static MagickException^ Read(Magick::Image* image, MagickColor^ color,
 			int width, int height);
 		//===========================================================================================
@@ -13,6 +13,7 @@
 //=================================================================================================
 #include "Stdafx.h"
 #include "..\Helpers\FileHelper.h"
+#include "..\Helpers\YuvConverter.h"
 #include "MagickWriter.h"
 
 using namespace System::Runtime::InteropServices;
@@ -57,6 +58,79 @@ namespace GraphicsMagick
 		}
 	}
 	//==============================================================================================
+	MagickException^ MagickWriter::Write(const Magick::Image* image, int x, int y, int width,
+		int height, String^ map, StorageType storageType, IntPtr destination, int stride)
+	{
+		Throw::IfTrue("destination", destination == IntPtr::Zero, "The pointer to the destination cannot be zero.");
+		Throw::IfNullOrEmpty("map", map);
+		Throw::IfTrue("width", width < 1, "The width should be at least 1.");
+		Throw::IfTrue("height", height < 1, "The height should be at least 1.");
+		Throw::IfTrue("x", x < 0 || x + width > (int)image->columns(), "The area should be inside the image.");
+		Throw::IfTrue("y", y < 0 || y + height > (int)image->rows(), "The area should be inside the image.");
+
+		int rowSize = width * map->Length * Marshaller::SizeOf(storageType);
+		Throw::IfTrue("stride", stride < rowSize, "The stride should be at least {0}.", rowSize);
+
+		std::string magickMap;
+		Marshaller::Marshal(map, magickMap);
+
+		MagickLib::ExceptionInfo exceptionInfo;
+		MagickLib::GetExceptionInfo(&exceptionInfo);
+
+		try
+		{
+			unsigned char* pixels = (unsigned char*)destination.ToPointer();
+			if (stride == rowSize)
+			{
+				(void) MagickLib::DispatchImage(image->constImage(), x, y, width, height,
+					magickMap.c_str(), (MagickLib::StorageType)storageType, pixels, &exceptionInfo);
+			}
+			else
+			{
+				for (int row = 0; row < height; row++)
+				{
+					if (!MagickLib::DispatchImage(image->constImage(), x, y + row, width, 1,
+						magickMap.c_str(), (MagickLib::StorageType)storageType, pixels, &exceptionInfo))
+						break;
+
+					pixels += stride;
+				}
+			}
+
+			Magick::throwException(exceptionInfo);
+			MagickLib::DestroyExceptionInfo(&exceptionInfo);
+
+			return nullptr;
+		}
+		catch (Magick::Exception& exception)
+		{
+			return MagickException::Create(exception);
+		}
+	}
+	//==============================================================================================
+	MagickException^ MagickWriter::Write(const Magick::Image* image, YuvFormat format,
+		IntPtr destination)
+	{
+		Throw::IfTrue("destination", destination == IntPtr::Zero, "The pointer to the destination cannot be zero.");
+
+		MagickLib::ExceptionInfo exceptionInfo;
+		MagickLib::GetExceptionInfo(&exceptionInfo);
+
+		try
+		{
+			(void) YuvConverter::Export(image->constImage(), format, (unsigned char*)destination.ToPointer(),
+				&exceptionInfo);
+			Magick::throwException(exceptionInfo);
+			MagickLib::DestroyExceptionInfo(&exceptionInfo);
+
+			return nullptr;
+		}
+		catch (Magick::Exception& exception)
+		{
+			return MagickException::Create(exception);
+		}
+	}
+	//==============================================================================================
 	MagickException^ MagickWriter::Write(Magick::Image* image, Stream^ stream)
 	{
 		Throw::IfNull("stream", stream);
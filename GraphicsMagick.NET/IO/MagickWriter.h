@@ -13,6 +13,7 @@
 //=================================================================================================
 #pragma once
 
+#include "..\Enums\YuvFormat.h"
 #include "..\Exceptions\Base\MagickException.h"
 
 using namespace System::IO;
@@ -31,6 +32,11 @@ namespace GraphicsMagick
 		//===========================================================================================
 		static MagickException^ Write(Magick::Image* image, Magick::Blob* blob);
 		//===========================================================================================
+		static MagickException^ Write(const Magick::Image* image, int x, int y, int width, int height,
+			String^ map, StorageType storageType, IntPtr destination, int stride);
+		//===========================================================================================
+		static MagickException^ Write(const Magick::Image* image, YuvFormat format, IntPtr destination);
+		//===========================================================================================
 		static MagickException^ Write(Magick::Image* image, Stream^ stream);
 		//===========================================================================================
 		static MagickException^ Write(Magick::Image* image, String^ fileName);
@@ -17,6 +17,7 @@
 #include "Helpers\EnumHelper.h"
 
 using namespace System::Globalization;
+using namespace System::Threading;
 
 namespace GraphicsMagick
 {
@@ -37,7 +38,79 @@ namespace GraphicsMagick
 		}
 	}
 	//==============================================================================================
-	Collection<MagickFormatInfo^>^ MagickFormatInfo::LoadFormats()
+	MagickFormatInfo^ MagickFormatInfo::Create(const Magick::CoderInfo& coderInfo, MagickFormat format)
+	{
+		MagickFormatInfo^ formatInfo = gcnew MagickFormatInfo();
+		formatInfo->_Format = format;
+		formatInfo->_Description = Marshaller::Marshal(coderInfo.description());
+		formatInfo->_CoderInfo = new Magick::CoderInfo(coderInfo);
+
+		return formatInfo;
+	}
+	//==============================================================================================
+	MagickFormat MagickFormatInfo::GetFormat(String^ name)
+	{
+		name = name->Replace("-", "");
+		if (name == "3FR")
+			name = "ThreeFr";
+
+		return EnumHelper::Parse<MagickFormat>(name, MagickFormat::Unknown);
+	}
+	//==============================================================================================
+	String^ MagickFormatInfo::GetName(MagickFormat format)
+	{
+		if (format == MagickFormat::ThreeFr)
+			return "3FR";
+
+		return Enum::GetName(MagickFormat::typeid, format)->ToUpperInvariant();
+	}
+	//==============================================================================================
+	bool MagickFormatInfo::IsListed(const Magick::CoderInfo& coderInfo, MagickFormat format)
+	{
+		String^ name = Marshaller::Marshal(coderInfo.name())->Replace("-", "");
+		if (GetFormat(name) != format)
+			return false;
+
+		if (Array::IndexOf(_ListedStealthFormats, name) != -1)
+			return true;
+
+		MagickLib::ExceptionInfo exceptionInfo;
+		MagickLib::GetExceptionInfo(&exceptionInfo);
+		const MagickLib::MagickInfo* magickInfo = MagickLib::GetMagickInfo(coderInfo.name().c_str(), &exceptionInfo);
+		MagickLib::DestroyExceptionInfo(&exceptionInfo);
+
+		return magickInfo != NULL && !magickInfo->stealth;
+	}
+	//==============================================================================================
+	MagickFormatInfo^ MagickFormatInfo::LoadFormat(MagickFormat format)
+	{
+		String^ name = GetName(format);
+		if (_CustomStealthFormats->Contains(name))
+			return nullptr;
+
+		std::string coderName;
+		Marshaller::Marshal(name, coderName);
+
+		// Only the module of this format is loaded, the list of all the coders is used when the
+		// name of the coder cannot be created from the name of the format.
+		try
+		{
+			Magick::CoderInfo coderInfo(coderName);
+
+			// The coders that are not in the list of all the coders are also skipped here, so the
+			// result does not depend on the order in which Get and All are used.
+			if (!IsListed(coderInfo, format))
+				return nullptr;
+
+			return Create(coderInfo, format);
+		}
+		catch(Magick::Exception&)
+		{
+			return nullptr;
+		}
+	}
+	//==============================================================================================
+	void MagickFormatInfo::LoadFormats()
 	{
 		Collection<MagickFormatInfo^>^ result = gcnew Collection<MagickFormatInfo^>();
 
@@ -52,33 +125,88 @@ namespace GraphicsMagick
 			MagickException::Throw(exception);
 		}
 
-		AddStealthCoder(&coderList, "DIB");
-		AddStealthCoder(&coderList, "TIF");
+		for each (String^ name in _ListedStealthFormats)
+		{
+			std::string coderName;
+			Marshaller::Marshal(name, coderName);
+			AddStealthCoder(&coderList, coderName);
+		}
 
 		std::list<Magick::CoderInfo>::const_iterator coder = coderList.begin(); 
 		while(coder != coderList.end())
 		{
-			MagickFormatInfo^ formatInfo = gcnew MagickFormatInfo();
-
-			String^ name = Marshaller::Marshal(coder->name());
+			String^ name = Marshaller::Marshal(coder->name())->Replace("-", "");
+			MagickFormat format = GetFormat(name);
 
-			name = name->Replace("-", "");
-			if (name == "3FR")
-				name = "ThreeFr";
-
-			if (!_CustomStealthFormats->Contains(name))
+			// The instances in the dictionary are used, so Get returns the same instance as All.
+			if (format != MagickFormat::Unknown && !_CustomStealthFormats->Contains(name))
 			{
-				formatInfo->_Format = EnumHelper::Parse<MagickFormat>(name, MagickFormat::Unknown);
-				formatInfo->_Description = Marshaller::Marshal(coder->description());
-				formatInfo->_CoderInfo = new Magick::CoderInfo(*coder);
+				MagickFormatInfo^ formatInfo;
+				if (!_Formats->TryGetValue(format, formatInfo) || formatInfo == nullptr)
+				{
+					formatInfo = Create(*coder, format);
+					_Formats[format] = formatInfo;
+				}
 
-				result->Add(formatInfo);
+				if (!result->Contains(formatInfo))
+					result->Add(formatInfo);
 			}
 
 			coder++;
 		} 
 
-		return result;
+		_All = result;
+	}
+	//==============================================================================================
+	Collection<MagickFormatInfo^>^ MagickFormatInfo::All::get()
+	{
+		Monitor::Enter(_Formats);
+		try
+		{
+			if (_All == nullptr)
+				LoadFormats();
+
+			return _All;
+		}
+		finally
+		{
+			Monitor::Exit(_Formats);
+		}
+	}
+	//==============================================================================================
+	MagickFormatInfo^ MagickFormatInfo::Get(MagickFormat format)
+	{
+		if (format == MagickFormat::Unknown)
+			return nullptr;
+
+		Monitor::Enter(_Formats);
+		try
+		{
+			MagickFormatInfo^ formatInfo;
+			if (_Formats->TryGetValue(format, formatInfo))
+				return formatInfo;
+
+			if (_All == nullptr)
+			{
+				formatInfo = LoadFormat(format);
+				if (formatInfo != nullptr)
+				{
+					_Formats[format] = formatInfo;
+					return formatInfo;
+				}
+
+				LoadFormats();
+				if (_Formats->TryGetValue(format, formatInfo))
+					return formatInfo;
+			}
+
+			_Formats[format] = nullptr;
+			return nullptr;
+		}
+		finally
+		{
+			Monitor::Exit(_Formats);
+		}
 	}
 	//==============================================================================================
 	String^ MagickFormatInfo::Description::get()
@@ -34,6 +34,9 @@ namespace GraphicsMagick
 			"8BIM", "8BIMTEXT", "8BIMWTEXT", "APP1", "APP1JPEG", "CACHE", "EXIF", "ICM", "ICC", "IMAGE",
 				"IPTC", "IPTCTEXT", "IPTCWTEXT", "XMP"
 		});
+		static initonly array<String^>^ _ListedStealthFormats = gcnew array<String^> { "DIB", "TIF" };
+		static initonly Dictionary<MagickFormat, MagickFormatInfo^>^ _Formats = gcnew Dictionary<MagickFormat, MagickFormatInfo^>();
+		static Collection<MagickFormatInfo^>^ _All;
 		//===========================================================================================
 		String^ _Description;
 		MagickFormat _Format;
@@ -43,11 +46,26 @@ namespace GraphicsMagick
 		//===========================================================================================
 		static void AddStealthCoder(std::list<Magick::CoderInfo>* coderList, std::string name);
 		//===========================================================================================
-		static Collection<MagickFormatInfo^>^ LoadFormats();
+		static MagickFormatInfo^ Create(const Magick::CoderInfo& coderInfo, MagickFormat format);
+		//===========================================================================================
+		static MagickFormat GetFormat(String^ name);
+		//===========================================================================================
+		static String^ GetName(MagickFormat format);
+		//===========================================================================================
+		static bool IsListed(const Magick::CoderInfo& coderInfo, MagickFormat format);
+		//===========================================================================================
+		static MagickFormatInfo^ LoadFormat(MagickFormat format);
+		//===========================================================================================
+		static void LoadFormats();
 		//===========================================================================================
 	internal:
 		//===========================================================================================
-		static initonly Collection<MagickFormatInfo^>^ All = LoadFormats();
+		static property Collection<MagickFormatInfo^>^ All
+		{
+			Collection<MagickFormatInfo^>^ get();
+		}
+		//===========================================================================================
+		static MagickFormatInfo^ Get(MagickFormat format);
 		//===========================================================================================
 	public:
 		///==========================================================================================
@@ -13,6 +13,8 @@
 //=================================================================================================
 #include "Stdafx.h"
 #include "Helpers\FileHelper.h"
+#include "Helpers\YuvConverter.h"
+#include "IO\DecodedCache.h"
 #include "MagickImage.h"
 #include "MagickImageCollection.h"
 #include "Quantum.h"
@@ -57,25 +59,6 @@ namespace GraphicsMagick
 		}
 	}
 	//==============================================================================================
-	unsigned char* MagickImage::ExportPixels(String^ map)
-	{
-		void* result = malloc(map->Length * Width * Height * sizeof(unsigned char*));
-
-		std::string magickMap;
-		Marshaller::Marshal(map, magickMap);
-
-		MagickLib::ExceptionInfo exceptionInfo;
-		MagickLib::GetExceptionInfo(&exceptionInfo);
-
-		(void) DispatchImage(Value->image(), 0, 0, Width, Height, magickMap.c_str(),
-			(Magick::StorageType)StorageType::Char, result, &exceptionInfo);
-
-		Magick::throwException(exceptionInfo);
-		MagickLib::DestroyExceptionInfo(&exceptionInfo);
-
-		return (unsigned char*)result;
-	}
-	//==============================================================================================
 	String^ MagickImage::FormatedFileSize()
 	{
 		Decimal fileSize = FileSize;
@@ -717,16 +700,7 @@ namespace GraphicsMagick
 	//==============================================================================================
 	MagickFormatInfo^ MagickImage::FormatInfo::get()
 	{
-		if (Format == MagickFormat::Unknown)
-			return nullptr;
-
-		for each(MagickFormatInfo^ info in MagickFormatInfo::All)
-		{
-			if (info->Format == Format)
-				return info;
-		}
-
-		return nullptr;
+		return MagickFormatInfo::Get(Format);
 	}
 	//==============================================================================================
 	GifDisposeMethod MagickImage::GifDisposeMethod::get()
@@ -1896,6 +1870,49 @@ namespace GraphicsMagick
 		}
 	}
 	//==============================================================================================
+	void MagickImage::ExportPixels(int x, int y, int width, int height, String^ map,
+		StorageType storageType, array<Byte>^ destination, int stride)
+	{
+		Throw::IfNullOrEmpty("destination", destination);
+		Throw::IfNullOrEmpty("map", map);
+		Throw::IfTrue("stride", stride < 1, "The stride should be at least 1.");
+
+		// The last row does not need the padding of the stride.
+		Int64 rowSize = (Int64)width * map->Length * Marshaller::SizeOf(storageType);
+		Int64 length = (Int64)stride * Math::Max(height - 1, 0) + rowSize;
+		Throw::IfTrue("destination", destination->Length < length,
+			"The array length is {0} but should be at least {1}.", destination->Length, length);
+
+		pin_ptr<Byte> pixels = &destination[0];
+		ExportPixels(x, y, width, height, map, storageType, IntPtr(pixels), stride);
+	}
+	//==============================================================================================
+	void MagickImage::ExportPixels(int x, int y, int width, int height, String^ map,
+		StorageType storageType, IntPtr destination, int stride)
+	{
+		HandleException(MagickWriter::Write(Value, x, y, width, height, map, storageType, destination, stride));
+	}
+	//==============================================================================================
+	void MagickImage::ExportPixels(YuvFormat format, array<Byte>^ destination)
+	{
+		Throw::IfNullOrEmpty("destination", destination);
+
+		int length = YuvConverter::GetLength(Width, Height, format);
+		Throw::IfTrue("destination", destination->Length < length,
+			"The array length is {0} but should be at least {1}.", destination->Length, length);
+
+		pin_ptr<Byte> pixels = &destination[0];
+		ExportPixels(format, IntPtr(pixels));
+	}
+	//==============================================================================================
+	void MagickImage::ExportPixels(YuvFormat format, IntPtr destination)
+	{
+		if (ColorSpace == GraphicsMagick::ColorSpace::CMYK)
+			ColorSpace = GraphicsMagick::ColorSpace::sRGB;
+
+		HandleException(MagickWriter::Write(Value, format, destination));
+	}
+	//==============================================================================================
 	void MagickImage::Extent(int width, int height)
 	{
 		MagickGeometry^ geometry = gcnew MagickGeometry(width, height);
@@ -2563,6 +2580,11 @@ namespace GraphicsMagick
 		}
 	}
 	//==============================================================================================
+	void MagickImage::LoadDecodedCache(String^ fileName)
+	{
+		HandleException(DecodedCache::Read(Value, fileName));
+	}
+	//==============================================================================================
 	void MagickImage::Lower(int size)
 	{
 		RaiseOrLower(size, false);
@@ -2856,6 +2878,17 @@ namespace GraphicsMagick
 		Read(file->FullName, readSettings);
 	}
 	//==============================================================================================
+	void MagickImage::Read(IntPtr data, int width, int height, String^ map, StorageType storageType,
+		int stride)
+	{
+		HandleException(MagickReader::Read(Value, data, width, height, map, storageType, stride));
+	}
+	//==============================================================================================
+	void MagickImage::Read(IntPtr data, int width, int height, YuvFormat format)
+	{
+		HandleException(MagickReader::Read(Value, data, width, height, format));
+	}
+	//==============================================================================================
 	void MagickImage::Read(MagickColor^ color, int width, int height)
 	{
 		HandleException(MagickReader::Read(Value, color, width, height));
@@ -3051,6 +3084,11 @@ namespace GraphicsMagick
 		Sample(geometry);
 	}
 	//==============================================================================================
+	void MagickImage::SaveDecodedCache(String^ fileName)
+	{
+		HandleException(DecodedCache::Write(Value, fileName));
+	}
+	//==============================================================================================
 	void MagickImage::Scale(int width, int height)
 	{
 		MagickGeometry^ geometry = gcnew MagickGeometry(width, height);
@@ -3424,36 +3462,26 @@ namespace GraphicsMagick
 			format = PixelFormat::Format32bppArgb;
 		}
 
-		unsigned char* pixels = (unsigned char*) NULL;
-
+		Bitmap^ bitmap = gcnew Bitmap(Width, Height, format);
 		try
 		{
-			pixels = ExportPixels(map);
-
-			Bitmap^ bitmap = gcnew Bitmap(Width, Height, format);
 			BitmapData^ data = bitmap->LockBits(Rectangle(0, 0, Width, Height), ImageLockMode::ReadWrite, format);
-			IntPtr destination = data->Scan0;
-			size_t stride = (map->Length * Width);
-			unsigned char* p = pixels;
-			for(int i=0; i < Height; i++)
+			try
 			{
-				MagickLib::MagickCloneMemory(destination.ToPointer(), p, stride);
-				p += stride;
-				destination = IntPtr(destination.ToInt64() + data->Stride);
+				ExportPixels(0, 0, Width, Height, map, StorageType::Char, data->Scan0, data->Stride);
+			}
+			finally
+			{
+				bitmap->UnlockBits(data);
 			}
-			bitmap->UnlockBits(data);
-			return bitmap;
-		}
-		catch(Magick::Exception& exception)
-		{
-			HandleException(exception);
-			return nullptr;
 		}
-		finally
+		catch (Exception^)
 		{
-			if (pixels != (unsigned char*) NULL)
-				MagickLib::MagickFree(pixels);
+			delete bitmap;
+			throw;
 		}
+
+		return bitmap;
 	}
 	//==============================================================================================
 	Bitmap^ MagickImage::ToBitmap(ImageFormat^ imageFormat)
@@ -3716,23 +3744,10 @@ namespace GraphicsMagick
 
 		int step = (format.BitsPerPixel / 8);
 		int stride = Width * step;
-		unsigned char* pixels = (unsigned char*) NULL;
 
-		try
-		{
-			pixels = ExportPixels(map);
-			return BitmapSource::Create(Width, Height, 96, 96, format, nullptr, IntPtr((void *) pixels), stride * Height, stride);
-		}
-		catch(Magick::Exception& exception)
-		{
-			HandleException(exception);
-			return nullptr;
-		}
-		finally
-		{
-			if (pixels != (unsigned char*) NULL)
-				MagickLib::MagickFree(pixels);
-		}
+		array<Byte>^ pixels = gcnew array<Byte>(stride * Height);
+		ExportPixels(0, 0, Width, Height, map, StorageType::Char, pixels, stride);
+		return BitmapSource::Create(Width, Height, 96, 96, format, nullptr, pixels, stride);
 	}
 	//==============================================================================================
 #endif
@@ -41,6 +41,7 @@
 #include "Enums\Resolution.h"
 #include "Enums\RenderingIntent.h"
 #include "Enums\VirtualPixelMethod.h"
+#include "Enums\YuvFormat.h"
 #include "Events\WarningEventArgs.h"
 #include "Exceptions\Base\MagickException.h"
 #include "Helpers\EnumHelper.h"
@@ -92,8 +93,6 @@ namespace GraphicsMagick
 		template<class TImageProfile>
 		TImageProfile^ CreateProfile(String^ name);
 		//===========================================================================================
-		unsigned char* ExportPixels(String^ map);
-		//===========================================================================================
 		String^ FormatedFileSize();
 		//===========================================================================================
 		static MagickFormat GetCoderFormat(MagickFormat format);
@@ -1281,6 +1280,56 @@ namespace GraphicsMagick
 		void Evaluate(Channels channels, MagickGeometry^ geometry, QuantumOperator evaluateOperator, double value);
 		///==========================================================================================
 		///<summary>
+		/// Exports the pixels of the specified area into the specified array.
+		///</summary>
+		///<param name="x">The X coordinate.</param>
+		///<param name="y">The Y coordinate.</param>
+		///<param name="width">The width of the pixel area.</param>
+		///<param name="height">The height of the pixel area.</param>
+		///<param name="map">The order of the channels (e.g. "RGB" or "BGRA").</param>
+		///<param name="storageType">The storage type of each channel.</param>
+		///<param name="destination">The array to write the pixels to.</param>
+		///<param name="stride">The number of bytes between the start of two rows.</param>
+		///<exception cref="MagickException"/>
+		void ExportPixels(int x, int y, int width, int height, String^ map, StorageType storageType,
+			array<Byte>^ destination, int stride);
+		///==========================================================================================
+		///<summary>
+		/// Exports the pixels of the specified area to the specified memory location.
+		///</summary>
+		///<param name="x">The X coordinate.</param>
+		///<param name="y">The Y coordinate.</param>
+		///<param name="width">The width of the pixel area.</param>
+		///<param name="height">The height of the pixel area.</param>
+		///<param name="map">The order of the channels (e.g. "RGB" or "BGRA").</param>
+		///<param name="storageType">The storage type of each channel.</param>
+		///<param name="destination">The pointer to the memory to write the pixels to.</param>
+		///<param name="stride">The number of bytes between the start of two rows.</param>
+		///<exception cref="MagickException"/>
+		void ExportPixels(int x, int y, int width, int height, String^ map, StorageType storageType,
+			IntPtr destination, int stride);
+		///==========================================================================================
+		///<summary>
+		/// Exports the pixels of the image as 8-bit YUV into the specified array. The width of the
+		/// image should be even and for I420 and NV12 the height should also be even.
+		///</summary>
+		///<param name="format">The YUV layout.</param>
+		///<param name="destination">The array to write the pixels to.</param>
+		///<exception cref="MagickException"/>
+		void ExportPixels(YuvFormat format, array<Byte>^ destination);
+		///==========================================================================================
+		///<summary>
+		/// Exports the pixels of the image as 8-bit YUV to the specified memory location. The width
+		/// of the image should be even and for I420 and NV12 the height should also be even. The
+		/// length of the memory cannot be validated, it should contain at least width * height * 3 / 2
+		/// bytes for I420 and NV12 and width * height * 2 bytes for YUY2.
+		///</summary>
+		///<param name="format">The YUV layout.</param>
+		///<param name="destination">The pointer to the memory to write the pixels to.</param>
+		///<exception cref="MagickException"/>
+		void ExportPixels(YuvFormat format, IntPtr destination);
+		///==========================================================================================
+		///<summary>
 		/// Extend the image as defined by the width and height.
 		///</summary>
 		///<param name="width">The width to extend the image to.</param>
@@ -1612,6 +1661,8 @@ namespace GraphicsMagick
 		///==========================================================================================
 		///<summary>
 		/// Returns a writable pixel collection that can be used to access the pixels of this image.
+		/// Multiple writable pixel collections can be used at the same time when their areas do not
+		/// overlap.
 		///</summary>
 		///<param name="x">The X coordinate.</param>
 		///<param name="y">The Y coordinate.</param>
@@ -1726,6 +1777,14 @@ namespace GraphicsMagick
 		QUANTUM_CLS_COMPLIANT void Level(Magick::Quantum blackPoint, Magick::Quantum whitePoint, double midpoint, Channels channels);
 		///==========================================================================================
 		///<summary>
+		/// Reads the decoded cache (MPC) that was written with SaveDecodedCache. The pixels are
+		/// memory-mapped from the .cache file that is next to the specified file.
+		///</summary>
+		///<param name="fileName">The fully qualified name of the .mpc file.</param>
+		///<exception cref="MagickException"/>
+		void LoadDecodedCache(String^ fileName);
+		///==========================================================================================
+		///<summary>
 		/// Lower image (lighten or darken the edges of an image to give a 3-D lowered effect).
 		///</summary>
 		///<param name="size">The size of the edges.</param>
@@ -1962,6 +2021,33 @@ namespace GraphicsMagick
 		void Read(FileInfo^ file, MagickReadSettings^ readSettings);
 		///==========================================================================================
 		///<summary>
+		/// Read single image frame from the pixels at the specified memory location. The pixels are
+		/// imported directly from that memory, rows with padding are imported one by one. The length
+		/// of the memory cannot be validated, it should contain at least (height - 1) * stride bytes
+		/// plus the size of one row.
+		///</summary>
+		///<param name="data">The pointer to the first pixel.</param>
+		///<param name="width">The width.</param>
+		///<param name="height">The height.</param>
+		///<param name="map">The order of the channels (e.g. "RGB" or "BGRA").</param>
+		///<param name="storageType">The storage type of each channel.</param>
+		///<param name="stride">The number of bytes between the start of two rows.</param>
+		///<exception cref="MagickException"/>
+		void Read(IntPtr data, int width, int height, String^ map, StorageType storageType, int stride);
+		///==========================================================================================
+		///<summary>
+		/// Read single image frame from the 8-bit YUV pixels at the specified memory location. The
+		/// length of the memory cannot be validated, it should contain at least width * height * 3 / 2
+		/// bytes for I420 and NV12 and width * height * 2 bytes for YUY2.
+		///</summary>
+		///<param name="data">The pointer to the first byte of the Y plane.</param>
+		///<param name="width">The width.</param>
+		///<param name="height">The height.</param>
+		///<param name="format">The YUV layout.</param>
+		///<exception cref="MagickException"/>
+		void Read(IntPtr data, int width, int height, YuvFormat format);
+		///==========================================================================================
+		///<summary>
 		/// Read single vector image frame.
 		///</summary>
 		///<param name="color">The color to fill the image with.</param>
@@ -2118,6 +2204,14 @@ namespace GraphicsMagick
 		void Sample(Percentage percentageWidth, Percentage percentageHeight);
 		///==========================================================================================
 		///<summary>
+		/// Writes the decoded pixels of the image to the specified .mpc file and a .cache file next
+		/// to it, LoadDecodedCache can read these files without decoding the image again.
+		///</summary>
+		///<param name="fileName">The fully qualified name of the .mpc file.</param>
+		///<exception cref="MagickException"/>
+		void SaveDecodedCache(String^ fileName);
+		///==========================================================================================
+		///<summary>
 		/// Resize image by using simple ratio algorithm.
 		///</summary>
 		///<param name="width">The new width.</param>
@@ -175,23 +175,11 @@ namespace GraphicsMagick
 		long size = _Width * _Height * _Channels;
 
 		array<Magick::Quantum>^ result = gcnew array<Magick::Quantum>(size);
+		if (size == 0)
+			return result;
 
-		int index = 0;
-		long i = 0;
-		const Magick::PixelPacket* p = Pixels;
-
-		while (i < size)
-		{
-			result[i++] = p->red;
-			result[i++] = p->green;
-			result[i++] = p->blue;
-			result[i++] = p->opacity;
-
-			if (_Channels == 5)
-				result[i++] = _Indexes[index++];
-
-			p++;
-		}
+		pin_ptr<Magick::Quantum> data = &result[0];
+		Quantum::ToValues(Pixels, _Indexes, _Channels, _Width * _Height, data);
 
 		return result;
 	}
@@ -17,6 +17,12 @@
 
 namespace GraphicsMagick
 {
+	//==============================================================================================
+	void WritablePixelCollection::MarkDirty(int firstRow, int lastRow)
+	{
+		for (int y = firstRow; y <= lastRow; y++)
+			_DirtyRows[y] = true;
+	}
 	//==============================================================================================
 	void WritablePixelCollection::SetPixel(int x, int y, array<Magick::Quantum>^ value)
 	{
@@ -25,23 +31,11 @@ namespace GraphicsMagick
 
 		int index = GetIndex(x, y);
 
-		Magick::PixelPacket *p = _Pixels + index;
-		SetPixel(p, value, 0);
-
-		if (Channels == 5)
-			Indexes[index] = Quantum::Convert(value[4]);
-	}
-	//==============================================================================================
-	template<typename TType>
-	int WritablePixelCollection::SetPixel(Magick::PixelPacket *pixel, array<TType>^ value, int index)
-	{
-		pixel->red = Quantum::Convert(value[index++]);
-		pixel->green = Quantum::Convert(value[index++]);
-		pixel->blue = Quantum::Convert(value[index++]);
-		if (Channels > 3)
-			pixel->opacity = Quantum::Convert(value[index++]);
+		pin_ptr<Magick::Quantum> data = &value[0];
+		Quantum::ToPixels((const Magick::Quantum*)data, Channels, 1, _Pixels + index,
+			Channels == 5 ? Indexes + index : NULL);
 
-		return index;
+		_DirtyRows[y] = true;
 	}
 	//==============================================================================================
 	template<typename TType>
@@ -50,19 +44,32 @@ namespace GraphicsMagick
 		Throw::IfNullOrEmpty("values", values);
 		Throw::IfFalse("values", values->Length % Channels == 0, "Values should have {0} channels.", Channels);
 
-		long i = 0;
-		int index = 0;
-		Magick::PixelPacket* p = _Pixels;
+		int count = values->Length / Channels;
+		Throw::IfTrue("values", count > Width * Height, "Values should not contain more than {0} pixels.", Width * Height);
 
-		while (i < values->Length)
-		{
-			i = SetPixel(p, values, i);
+		pin_ptr<TType> data = &values[0];
+		Quantum::ToPixels((const TType*)data, Channels, count, _Pixels, Indexes);
+
+		MarkDirty(0, (count - 1) / Width);
+	}
+	//==============================================================================================
+	void WritablePixelCollection::SyncRows(Magick::Pixels* view, int firstRow, int count)
+	{
+		int offset = firstRow * Width;
+		int length = count * Width;
 
-			if (Channels == 5)
-				Indexes[index++] = Quantum::Convert((TType)values[i++]);
+		Magick::PixelPacket* pixels = view->set(_Region.X, _Region.Y + firstRow, Width, count);
+		if (pixels != _Pixels + offset)
+			memcpy(pixels, _Pixels + offset, length * sizeof(Magick::PixelPacket));
 
-			p++;
+		if (Channels == 5)
+		{
+			Magick::IndexPacket* indexes = view->indexes();
+			if (indexes != Indexes + offset)
+				memcpy(indexes, Indexes + offset, length * sizeof(Magick::IndexPacket));
 		}
+
+		view->sync();
 	}
 	//==============================================================================================
 	const Magick::PixelPacket* WritablePixelCollection::Pixels::get()
@@ -70,15 +77,20 @@ namespace GraphicsMagick
 		return _Pixels;
 	}
 	//==============================================================================================
-	WritablePixelCollection::WritablePixelCollection(Magick::Image* image, int x, int y, int width, int height)
+	WritablePixelCollection::WritablePixelCollection(Magick::Image* image, int x, int y, int width,
+		int height)
 		: PixelBaseCollection(image, width, height)
 	{
 		Throw::IfTrue("width", x + width > (int)image->size().width(), "Invalid X coordinate specified: {0}.", x);
 		Throw::IfTrue("height", y + height > (int)image->size().height(), "Invalid Y coordinate specified: {0}.", y);
 
+		_Region = Rectangle(x, y, width, height);
+		_DirtyRows = gcnew array<bool>(height);
+		_Image = image;
+
 		try
 		{
-			_Pixels = View->set(x, y, width, height);
+			_Pixels = View->get(x, y, width, height);
 			CheckPixels();
 			LoadIndexes();
 		}
@@ -145,7 +157,49 @@ namespace GraphicsMagick
 	//==============================================================================================
 	void WritablePixelCollection::Write()
 	{
-		View->sync();
+		int dirtyRows = 0;
+		for (int y = 0; y < Height; y++)
+		{
+			if (_DirtyRows[y])
+				dirtyRows++;
+		}
+
+		if (dirtyRows == 0)
+			return;
+
+		try
+		{
+			if (dirtyRows == Height)
+			{
+				View->sync();
+			}
+			else
+			{
+				Magick::Pixels view(*_Image);
+
+				int y = 0;
+				while (y < Height)
+				{
+					if (!_DirtyRows[y])
+					{
+						y++;
+						continue;
+					}
+
+					int firstRow = y;
+					while (y < Height && _DirtyRows[y])
+						y++;
+
+					SyncRows(&view, firstRow, y - firstRow);
+				}
+			}
+		}
+		catch(Magick::Exception& exception)
+		{
+			MagickException::Throw(exception);
+		}
+
+		Array::Clear(_DirtyRows, 0, Height);
 	}
 	//==============================================================================================
 }
\ No newline at end of file
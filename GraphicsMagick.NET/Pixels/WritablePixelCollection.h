@@ -17,12 +17,14 @@
 #include "Base\PixelBaseCollection.h"
 
 using namespace System::Collections::Generic;
+using namespace System::Drawing;
 
 namespace GraphicsMagick
 {
 	///=============================================================================================
 	///<summary>
-	/// Class that can be used to access the individual pixels of an image and modify them.
+	/// Class that can be used to access the individual pixels of an image and modify them. Only the
+	/// rows that have been changed are written to the image.
 	///</summary>
 	//==============================================================================================
 	public ref class WritablePixelCollection sealed : PixelBaseCollection
@@ -30,16 +32,20 @@ namespace GraphicsMagick
 		//===========================================================================================
 	private:
 		//===========================================================================================
+		array<bool>^ _DirtyRows;
+		Magick::Image* _Image;
 		Magick::PixelPacket* _Pixels;
+		Rectangle _Region;
 		//===========================================================================================
-		void SetPixel(int x, int y, array<Magick::Quantum>^ value);
+		void MarkDirty(int firstRow, int lastRow);
 		//===========================================================================================
-		template<typename TType>
-		int SetPixel(Magick::PixelPacket *pixel, array<TType>^ value, int index);
+		void SetPixel(int x, int y, array<Magick::Quantum>^ value);
 		//===========================================================================================
 		template<typename TType>
 		void SetPixels(array<TType>^ values);
 		//===========================================================================================
+		void SyncRows(Magick::Pixels* view, int firstRow, int count);
+		//===========================================================================================
 	protected private:
 		//===========================================================================================
 		property const Magick::PixelPacket* Pixels
@@ -116,7 +122,7 @@ namespace GraphicsMagick
 #endif
 		///==========================================================================================
 		///<summary>
-		/// Writes the pixels to the image.
+		/// Writes the rows that have been changed since the last call to the image.
 		///</summary>
 		void Write();
 		//===========================================================================================
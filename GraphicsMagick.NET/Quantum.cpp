@@ -13,6 +13,247 @@
 //=================================================================================================
 #include "Stdafx.h"
 #include "Quantum.h"
+#include "Helpers\SimdHelper.h"
+#include <emmintrin.h>
+
+// The bulk conversions are compiled as native code, the managed code only pins the arrays and
+// passes the pointers. With a quantum depth of 16 the byte widening and the swap between the RGBA
+// order of the values and the BGRA order of the pixel cache are done with SSE2 when the processor
+// supports it, the scalar loops handle the remaining pixels and the other types.
+#pragma managed(push, off)
+namespace
+{
+	//==============================================================================================
+	inline MagickLib::Quantum ToQuantum(unsigned char value)
+	{
+#if (QuantumDepth == 8)
+		return (MagickLib::Quantum) value;
+#elif (QuantumDepth == 16)
+		return (MagickLib::Quantum) (257U * value);
+#else
+#error Not implemented!
+#endif
+	}
+	//==============================================================================================
+	inline MagickLib::Quantum ToQuantum(double value)
+	{
+		return (MagickLib::Quantum) value;
+	}
+	//==============================================================================================
+	inline MagickLib::Quantum ToQuantum(unsigned int value)
+	{
+		return (MagickLib::Quantum) value;
+	}
+	//==============================================================================================
+	inline MagickLib::Quantum ToQuantum(unsigned short value)
+	{
+		return (MagickLib::Quantum) value;
+	}
+	//==============================================================================================
+	template<typename TType>
+	void ToPixels(const TType* values, int channels, int start, int count,
+		MagickLib::PixelPacket* pixels, MagickLib::IndexPacket* indexes)
+	{
+		if (channels == 4)
+		{
+			for (int i = start; i < count; i++)
+			{
+				const TType* value = values + (i * 4);
+				pixels[i].red = ToQuantum(value[0]);
+				pixels[i].green = ToQuantum(value[1]);
+				pixels[i].blue = ToQuantum(value[2]);
+				pixels[i].opacity = ToQuantum(value[3]);
+			}
+		}
+		else
+		{
+			for (int i = start; i < count; i++)
+			{
+				const TType* value = values + (i * 5);
+				pixels[i].red = ToQuantum(value[0]);
+				pixels[i].green = ToQuantum(value[1]);
+				pixels[i].blue = ToQuantum(value[2]);
+				pixels[i].opacity = ToQuantum(value[3]);
+				indexes[i] = ToQuantum(value[4]);
+			}
+		}
+	}
+	//==============================================================================================
+	void ToValues(const MagickLib::PixelPacket* pixels, const MagickLib::IndexPacket* indexes,
+		int channels, int start, int count, MagickLib::Quantum* values)
+	{
+		if (channels == 4)
+		{
+			for (int i = start; i < count; i++)
+			{
+				MagickLib::Quantum* value = values + (i * 4);
+				value[0] = pixels[i].red;
+				value[1] = pixels[i].green;
+				value[2] = pixels[i].blue;
+				value[3] = pixels[i].opacity;
+			}
+		}
+		else
+		{
+			for (int i = start; i < count; i++)
+			{
+				MagickLib::Quantum* value = values + (i * 5);
+				value[0] = pixels[i].red;
+				value[1] = pixels[i].green;
+				value[2] = pixels[i].blue;
+				value[3] = pixels[i].opacity;
+				value[4] = indexes[i];
+			}
+		}
+	}
+	//==============================================================================================
+#if (QuantumDepth == 16) && !defined(WORDS_BIGENDIAN)
+	// Swaps the first and the third channel of each group of four 16-bit values, this converts
+	// RGBA to BGRA and back.
+	inline __m128i SwapRedBlue(__m128i value)
+	{
+		value = _mm_shufflelo_epi16(value, _MM_SHUFFLE(3, 0, 1, 2));
+		return _mm_shufflehi_epi16(value, _MM_SHUFFLE(3, 0, 1, 2));
+	}
+	//==============================================================================================
+	// Widens the bytes to 16 bits by repeating them in the high byte, this is the same as
+	// multiplying them by 257.
+	inline __m128i WidenLow(__m128i value)
+	{
+		return _mm_unpacklo_epi8(value, value);
+	}
+	//==============================================================================================
+	inline __m128i WidenHigh(__m128i value)
+	{
+		return _mm_unpackhi_epi8(value, value);
+	}
+	//==============================================================================================
+	// The methods below return the index of the first pixel that they did not convert. The loads
+	// and stores of the five channel methods are wider than a pixel so they stop early enough to
+	// stay inside the arrays.
+	int ToPixelsSse2(const unsigned char* values, int channels, int count,
+		MagickLib::PixelPacket* pixels, MagickLib::IndexPacket* indexes)
+	{
+		int i = 0;
+
+		if (channels == 4)
+		{
+			for (; i + 4 <= count; i += 4)
+			{
+				__m128i value = _mm_loadu_si128((const __m128i*)(values + (i * 4)));
+				_mm_storeu_si128((__m128i*)(pixels + i), SwapRedBlue(WidenLow(value)));
+				_mm_storeu_si128((__m128i*)(pixels + i + 2), SwapRedBlue(WidenHigh(value)));
+			}
+		}
+		else
+		{
+			for (; (i * 5) + 16 <= count * 5; i += 2)
+			{
+				__m128i value = _mm_loadu_si128((const __m128i*)(values + (i * 5)));
+				__m128i first = WidenLow(value);
+				__m128i second = WidenLow(_mm_srli_si128(value, 5));
+				_mm_storeu_si128((__m128i*)(pixels + i), SwapRedBlue(_mm_unpacklo_epi64(first, second)));
+				indexes[i] = (MagickLib::IndexPacket)_mm_extract_epi16(first, 4);
+				indexes[i + 1] = (MagickLib::IndexPacket)_mm_extract_epi16(second, 4);
+			}
+		}
+
+		return i;
+	}
+	//==============================================================================================
+	int ToPixelsSse2(const unsigned short* values, int channels, int count,
+		MagickLib::PixelPacket* pixels, MagickLib::IndexPacket* indexes)
+	{
+		int i = 0;
+
+		if (channels == 4)
+		{
+			for (; i + 2 <= count; i += 2)
+			{
+				__m128i value = _mm_loadu_si128((const __m128i*)(values + (i * 4)));
+				_mm_storeu_si128((__m128i*)(pixels + i), SwapRedBlue(value));
+			}
+		}
+		else
+		{
+			for (; (i * 5) + 8 <= count * 5; i++)
+			{
+				__m128i value = _mm_loadu_si128((const __m128i*)(values + (i * 5)));
+				_mm_storel_epi64((__m128i*)(pixels + i), SwapRedBlue(value));
+				indexes[i] = (MagickLib::IndexPacket)_mm_extract_epi16(value, 4);
+			}
+		}
+
+		return i;
+	}
+	//==============================================================================================
+	int ToValuesSse2(const MagickLib::PixelPacket* pixels, const MagickLib::IndexPacket* indexes,
+		int channels, int count, MagickLib::Quantum* values)
+	{
+		int i = 0;
+
+		if (channels == 4)
+		{
+			for (; i + 2 <= count; i += 2)
+			{
+				__m128i value = _mm_loadu_si128((const __m128i*)(pixels + i));
+				_mm_storeu_si128((__m128i*)(values + (i * 4)), SwapRedBlue(value));
+			}
+		}
+		else
+		{
+			// Each store also writes the first three values of the next pixel, these are
+			// overwritten when the next pixel is converted.
+			for (; (i * 5) + 8 <= count * 5; i++)
+			{
+				__m128i value = SwapRedBlue(_mm_loadl_epi64((const __m128i*)(pixels + i)));
+				value = _mm_insert_epi16(value, indexes[i], 4);
+				_mm_storeu_si128((__m128i*)(values + (i * 5)), value);
+			}
+		}
+
+		return i;
+	}
+	//==============================================================================================
+#endif
+	template<typename TType>
+	void ToNativePixels(const TType* values, int channels, int count, MagickLib::PixelPacket* pixels,
+		MagickLib::IndexPacket* indexes, bool)
+	{
+		ToPixels(values, channels, 0, count, pixels, indexes);
+	}
+	//==============================================================================================
+#if (QuantumDepth == 16) && !defined(WORDS_BIGENDIAN)
+	void ToNativePixels(const unsigned char* values, int channels, int count,
+		MagickLib::PixelPacket* pixels, MagickLib::IndexPacket* indexes, bool useSse2)
+	{
+		int start = useSse2 ? ToPixelsSse2(values, channels, count, pixels, indexes) : 0;
+		ToPixels(values, channels, start, count, pixels, indexes);
+	}
+	//==============================================================================================
+	void ToNativePixels(const unsigned short* values, int channels, int count,
+		MagickLib::PixelPacket* pixels, MagickLib::IndexPacket* indexes, bool useSse2)
+	{
+		int start = useSse2 ? ToPixelsSse2(values, channels, count, pixels, indexes) : 0;
+		ToPixels(values, channels, start, count, pixels, indexes);
+	}
+	//==============================================================================================
+	void ToNativeValues(const MagickLib::PixelPacket* pixels, const MagickLib::IndexPacket* indexes,
+		int channels, int count, MagickLib::Quantum* values, bool useSse2)
+	{
+		int start = useSse2 ? ToValuesSse2(pixels, indexes, channels, count, values) : 0;
+		ToValues(pixels, indexes, channels, start, count, values);
+	}
+#else
+	void ToNativeValues(const MagickLib::PixelPacket* pixels, const MagickLib::IndexPacket* indexes,
+		int channels, int count, MagickLib::Quantum* values, bool)
+	{
+		ToValues(pixels, indexes, channels, 0, count, values);
+	}
+#endif
+	//==============================================================================================
+}
+#pragma managed(pop)
 
 namespace GraphicsMagick
 {
@@ -55,6 +296,36 @@ namespace GraphicsMagick
 		return ((double) 1.0/(double) Max)*value;
 	}
 	//==============================================================================================
+	void Quantum::ToPixels(const Byte* values, int channels, int count, Magick::PixelPacket* pixels,
+		Magick::IndexPacket* indexes)
+	{
+		ToNativePixels(values, channels, count, pixels, indexes, SimdHelper::IsSse2Supported());
+	}
+	//==============================================================================================
+	void Quantum::ToPixels(const double* values, int channels, int count,
+		Magick::PixelPacket* pixels, Magick::IndexPacket* indexes)
+	{
+		ToNativePixels(values, channels, count, pixels, indexes, SimdHelper::IsSse2Supported());
+	}
+	//==============================================================================================
+	void Quantum::ToPixels(const unsigned int* values, int channels, int count,
+		Magick::PixelPacket* pixels, Magick::IndexPacket* indexes)
+	{
+		ToNativePixels(values, channels, count, pixels, indexes, SimdHelper::IsSse2Supported());
+	}
+	//==============================================================================================
+	void Quantum::ToPixels(const unsigned short* values, int channels, int count,
+		Magick::PixelPacket* pixels, Magick::IndexPacket* indexes)
+	{
+		ToNativePixels(values, channels, count, pixels, indexes, SimdHelper::IsSse2Supported());
+	}
+	//==============================================================================================
+	void Quantum::ToValues(const Magick::PixelPacket* pixels, const Magick::IndexPacket* indexes,
+		int channels, int count, Magick::Quantum* values)
+	{
+		ToNativeValues(pixels, indexes, channels, count, values, SimdHelper::IsSse2Supported());
+	}
+	//==============================================================================================
 	int Quantum::Depth::get()
 	{
 		return QuantumDepth;
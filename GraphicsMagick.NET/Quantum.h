@@ -42,6 +42,21 @@ namespace GraphicsMagick
 		//===========================================================================================
 		static double Scale(Magick::Quantum value);
 		//===========================================================================================
+		static void ToPixels(const Byte* values, int channels, int count,
+			Magick::PixelPacket* pixels, Magick::IndexPacket* indexes);
+		//===========================================================================================
+		static void ToPixels(const double* values, int channels, int count,
+			Magick::PixelPacket* pixels, Magick::IndexPacket* indexes);
+		//===========================================================================================
+		static void ToPixels(const unsigned int* values, int channels, int count,
+			Magick::PixelPacket* pixels, Magick::IndexPacket* indexes);
+		//===========================================================================================
+		static void ToPixels(const unsigned short* values, int channels, int count,
+			Magick::PixelPacket* pixels, Magick::IndexPacket* indexes);
+		//===========================================================================================
+		static void ToValues(const Magick::PixelPacket* pixels, const Magick::IndexPacket* indexes,
+			int channels, int count, Magick::Quantum* values);
+		//===========================================================================================
 	public:
 		///==========================================================================================
 		///<summary>
@@ -0,0 +1,169 @@
+//=================================================================================================
+// Copyright 2014-2015 Dirk Lemstra <https://graphicsmagick.codeplex.com/>
+//
+// Licensed under the ImageMagick License (the "License"); you may not use this file except in 
+// compliance with the License. You may obtain a copy of the License at
+//
+//   http://www.imagemagick.org/script/license.php
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the
+// License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing permissions and
+// limitations under the License.
+//=================================================================================================
+#include "Stdafx.h"
+#include "CompiledScript.h"
+#include "ScriptVariables.h"
+#include "..\Arguments\MagickGeometry.h"
+#include "..\Colors\MagickColor.h"
+
+using namespace System::Threading;
+
+namespace GraphicsMagick
+{
+	//==============================================================================================
+	void CompiledScript::AddChildren(XmlElement^ element, List<XmlAttribute^>^ attributes)
+	{
+		for each(XmlAttribute^ attribute in element->Attributes)
+		{
+			attributes->Add(attribute);
+		}
+
+		List<XmlElement^>^ children = gcnew List<XmlElement^>();
+
+		for each(XmlNode^ node in element->ChildNodes)
+		{
+			XmlElement^ child = dynamic_cast<XmlElement^>(node);
+			if (child == nullptr)
+				continue;
+
+			children->Add(child);
+			AddChildren(child, attributes);
+		}
+
+		_Children[element] = children->ToArray();
+	}
+	//==============================================================================================
+	Object^ CompiledScript::Copy(Object^ value)
+	{
+		// The geometries and colors are mutable and every execution gets its own instance.
+		MagickGeometry^ geometry = dynamic_cast<MagickGeometry^>(value);
+		if (geometry != nullptr)
+			return gcnew MagickGeometry(geometry);
+
+		MagickColor^ color = dynamic_cast<MagickColor^>(value);
+		if (color != nullptr)
+			return gcnew MagickColor(color);
+
+		return value;
+	}
+	//==============================================================================================
+	CompiledScript::CompiledScript(XmlDocument^ script)
+	{
+		_Children = gcnew Dictionary<XmlElement^, array<XmlElement^>^>();
+		_Script = script;
+
+		List<XmlAttribute^>^ attributes = gcnew List<XmlAttribute^>();
+		AddChildren(script->DocumentElement, attributes);
+
+		_Attributes = attributes->ToArray();
+		_Names = gcnew array<array<String^>^>(_Attributes->Length);
+
+		List<String^>^ variableNames = gcnew List<String^>();
+		for (int i = 0; i < _Attributes->Length; i++)
+		{
+			_Names[i] = ScriptVariables::GetNames(_Attributes[i]->Value);
+			if (_Names[i] == nullptr)
+				continue;
+
+			for each(String^ name in _Names[i])
+			{
+				if (!variableNames->Contains(name))
+					variableNames->Add(name);
+			}
+		}
+
+		_VariableNames = variableNames->ToArray();
+	}
+	//==============================================================================================
+	bool CompiledScript::IsCompiled::get()
+	{
+		return _Indexes != nullptr;
+	}
+	//==============================================================================================
+	XmlDocument^ CompiledScript::Script::get()
+	{
+		return _Script;
+	}
+	//==============================================================================================
+	IEnumerable<String^>^ CompiledScript::VariableNames::get()
+	{
+		return _VariableNames;
+	}
+	//==============================================================================================
+	void CompiledScript::Compile()
+	{
+		// The instance is shared by all the scripts with the same content.
+		Monitor::Enter(_Children);
+		try
+		{
+			if (IsCompiled)
+				return;
+
+			Dictionary<XmlAttribute^, int>^ indexes = gcnew Dictionary<XmlAttribute^, int>(_Attributes->Length);
+			array<Object^>^ values = gcnew array<Object^>(_Attributes->Length);
+
+			for (int i = 0; i < _Attributes->Length; i++)
+			{
+				indexes[_Attributes[i]] = i;
+				values[i] = _NotConverted;
+			}
+
+			_Values = values;
+			_Indexes = indexes;
+		}
+		finally
+		{
+			Monitor::Exit(_Children);
+		}
+	}
+	//==============================================================================================
+	array<XmlElement^>^ CompiledScript::GetChildren(XmlElement^ element)
+	{
+		return _Children[element];
+	}
+	//==============================================================================================
+	void CompiledScript::SetValue(XmlAttribute^ attribute, Object^ value)
+	{
+		// The index is never changed after Compile so the value can be stored without a lock, two
+		// threads that convert the same attribute at the same time store an equal value.
+		int index;
+		if (_Indexes->TryGetValue(attribute, index))
+			_Values[index] = Copy(value);
+	}
+	//==============================================================================================
+	bool CompiledScript::TryGetNames(XmlAttribute^ attribute, array<String^>^% names)
+	{
+		int index;
+		if (!_Indexes->TryGetValue(attribute, index))
+			return false;
+
+		names = _Names[index];
+		return true;
+	}
+	//==============================================================================================
+	bool CompiledScript::TryGetValue(XmlAttribute^ attribute, Object^% value)
+	{
+		int index;
+		if (!_Indexes->TryGetValue(attribute, index))
+			return false;
+
+		Object^ compiledValue = _Values[index];
+		if (compiledValue == _NotConverted)
+			return false;
+
+		value = Copy(compiledValue);
+		return true;
+	}
+	//==============================================================================================
+}
\ No newline at end of file
@@ -0,0 +1,72 @@
+//=================================================================================================
+// Copyright 2014-2015 Dirk Lemstra <https://graphicsmagick.codeplex.com/>
+//
+// Licensed under the ImageMagick License (the "License"); you may not use this file except in 
+// compliance with the License. You may obtain a copy of the License at
+//
+//   http://www.imagemagick.org/script/license.php
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the
+// License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing permissions and
+// limitations under the License.
+//=================================================================================================
+#pragma once
+
+using namespace System::Collections::Generic;
+using namespace System::Xml;
+
+namespace GraphicsMagick
+{
+	//==============================================================================================
+	private ref class CompiledScript sealed
+	{
+		//===========================================================================================
+	private:
+		//===========================================================================================
+		static initonly Object^ _NotConverted = gcnew Object();
+		//===========================================================================================
+		array<XmlAttribute^>^ _Attributes;
+		Dictionary<XmlElement^, array<XmlElement^>^>^ _Children;
+		Dictionary<XmlAttribute^, int>^ _Indexes;
+		array<array<String^>^>^ _Names;
+		XmlDocument^ _Script;
+		array<Object^>^ _Values;
+		array<String^>^ _VariableNames;
+		//===========================================================================================
+		void AddChildren(XmlElement^ element, List<XmlAttribute^>^ attributes);
+		//===========================================================================================
+		static Object^ Copy(Object^ value);
+		//===========================================================================================
+	internal:
+		//===========================================================================================
+		CompiledScript(XmlDocument^ script);
+		//===========================================================================================
+		property bool IsCompiled
+		{
+			bool get();
+		}
+		//===========================================================================================
+		property XmlDocument^ Script
+		{
+			XmlDocument^ get();
+		}
+		//===========================================================================================
+		property IEnumerable<String^>^ VariableNames
+		{
+			IEnumerable<String^>^ get();
+		}
+		//===========================================================================================
+		void Compile();
+		//===========================================================================================
+		array<XmlElement^>^ GetChildren(XmlElement^ element);
+		//===========================================================================================
+		void SetValue(XmlAttribute^ attribute, Object^ value);
+		//===========================================================================================
+		bool TryGetNames(XmlAttribute^ attribute, array<String^>^% names);
+		//===========================================================================================
+		bool TryGetValue(XmlAttribute^ attribute, Object^% value);
+		//===========================================================================================
+	};
+	//==============================================================================================
+}
\ No newline at end of file
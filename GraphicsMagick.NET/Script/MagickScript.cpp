@@ -13,11 +13,15 @@
 //=================================================================================================
 #include "Stdafx.h"
 #include "..\Helpers\FileHelper.h"
+#include "..\Helpers\ThreadHelper.h"
 #include "..\Helpers\XmlHelper.h"
+#include "..\IO\MagickReader.h"
 #include "..\MagickImageCollection.h"
 #include "MagickScript.h"
+#include "ScriptCache.h"
 
 using namespace System::Reflection;
+using namespace System::Threading;
 using namespace System::Xml::Schema;
 
 namespace GraphicsMagick
@@ -64,7 +68,7 @@ namespace GraphicsMagick
 	{
 		Collection<PathBase^>^ paths = gcnew Collection<PathBase^>();
 
-		for each (XmlElement^ elem in element->SelectNodes("*"))
+		for each (XmlElement^ elem in GetChildren(element))
 		{
 			ExecutePath(elem, paths);
 		}
@@ -97,6 +101,7 @@ namespace GraphicsMagick
 		{
 			XmlReader^ xmlReader = XmlReader::Create(resourceStream);
 			settings->Schemas->Add("", xmlReader);
+			settings->Schemas->Compile();
 			delete xmlReader;
 		}
 		catch(XmlException^)
@@ -108,11 +113,52 @@ namespace GraphicsMagick
 		return settings;
 	}
 	//==============================================================================================
+	void MagickScript::DisposeWrites(List<Object^>^ writes)
+	{
+		for each (Object^ write in writes)
+		{
+			ScriptBranch^ branch = dynamic_cast<ScriptBranch^>(write);
+			if (branch != nullptr)
+				DisposeWrites(branch->Writes);
+			else
+				delete ((ScriptWriteEventArgs^)write)->Image;
+		}
+
+		writes->Clear();
+	}
+	//==============================================================================================
+	void MagickScript::EndBranches(List<Object^>^ previous, bool succeeded)
+	{
+		List<Object^>^ writes = _PendingWrites;
+		_PendingWrites = previous;
+
+		if (writes == nullptr)
+			return;
+
+		WaitForBranches(writes);
+
+		try
+		{
+			if (succeeded)
+				RaiseWrites(writes);
+		}
+		finally
+		{
+			DisposeWrites(writes);
+		}
+	}
+	//==============================================================================================
 	void MagickScript::Execute(XmlElement^ element, MagickImage^ image)
 	{
-		for each (XmlElement^ elem in element->SelectNodes("*[name() != 'settings']"))
+		for each (XmlElement^ elem in GetChildren(element))
 		{
-			ExecuteImage(elem, image);
+			if (elem->Name == "settings")
+				continue;
+
+			if (_IsTraced)
+				ExecuteTraced(elem, image);
+			else
+				ExecuteImage(elem, image);
 		}
 	}
 	//==============================================================================================
@@ -134,9 +180,110 @@ namespace GraphicsMagick
 		return ExecuteCollection(element, collection);
 	}
 	//==============================================================================================
+	void MagickScript::ExecuteBatchItem(XmlElement^ element, String^ fileName)
+	{
+		MagickReadSettings^ settings = CreateMagickReadSettings((XmlElement^)element->SelectSingleNode("settings"));
+
+		MagickImage^ image;
+		if (settings != nullptr)
+			image = gcnew MagickImage(fileName, settings);
+		else
+			image = gcnew MagickImage(fileName);
+
+		List<Object^>^ previous = StartBranches();
+		bool wasTraced = StartTrace();
+		bool succeeded = false;
+		try
+		{
+			Execute(element, image);
+			succeeded = true;
+		}
+		finally
+		{
+			try
+			{
+				_IsTraced = wasTraced;
+				EndBranches(previous, succeeded);
+			}
+			finally
+			{
+				delete image;
+			}
+		}
+	}
+	//==============================================================================================
+	void MagickScript::ExecuteBatchItems(Object^ state)
+	{
+		ScriptBatch^ batch = (ScriptBatch^)state;
+
+		String^ fileName;
+		while (batch->TryGetNext(fileName))
+		{
+			try
+			{
+				ExecuteBatchItem(batch->Element, fileName);
+			}
+			catch (Exception^ exception)
+			{
+				batch->AddError(fileName, exception);
+			}
+		}
+	}
+	//==============================================================================================
+	void MagickScript::ExecuteBranch(Object^ state)
+	{
+		ScriptBranch^ branch = (ScriptBranch^)state;
+
+		List<Object^>^ previous = _PendingWrites;
+		_PendingWrites = branch->Writes;
+		bool wasTraced = _IsTraced;
+		_IsTraced = branch->IsTraced;
+
+		try
+		{
+			Execute(branch->Element, branch->Image);
+		}
+		catch (Exception^ exception)
+		{
+			branch->Error = exception;
+		}
+		finally
+		{
+			_PendingWrites = previous;
+			_IsTraced = wasTraced;
+
+			// The writes of the branch have their own copy of the image.
+			delete branch->Image;
+
+			if (branch->IsPooled)
+				Interlocked::Decrement(_ActiveWorkers);
+
+			branch->Complete();
+		}
+	}
+	//==============================================================================================
 	void MagickScript::ExecuteClone(XmlElement^ element, MagickImage^ image)
 	{
-		Execute(element, image->Clone());
+		if (_PendingWrites == nullptr)
+		{
+			Execute(element, image->Clone());
+			return;
+		}
+
+		ScriptBranch^ branch = gcnew ScriptBranch(element, image->Clone());
+		branch->IsTraced = _IsTraced;
+		_PendingWrites->Add(branch);
+
+		if (Interlocked::Increment(_ActiveWorkers) < _MaxDegreeOfParallelism)
+		{
+			branch->IsPooled = true;
+			ThreadPool::QueueUserWorkItem(gcnew WaitCallback(this, &MagickScript::ExecuteBranch), branch);
+		}
+		else
+		{
+			Interlocked::Decrement(_ActiveWorkers);
+			ExecuteBranch(branch);
+		}
 	}
 	//==============================================================================================
 	MagickImage^ MagickScript::ExecuteCollection(XmlElement^ element)
@@ -144,9 +291,13 @@ namespace GraphicsMagick
 		MagickImageCollection^ collection = gcnew MagickImageCollection();
 
 		MagickImage^ result;
-		for each (XmlElement^ elem in element->SelectNodes("*"))
+		for each (XmlElement^ elem in GetChildren(element))
 		{
-			result = Execute(elem, collection);
+			if (_IsTraced)
+				result = ExecuteTraced(elem, collection);
+			else
+				result = Execute(elem, collection);
+
 			if (result != nullptr)
 				break;
 		}
@@ -160,14 +311,60 @@ namespace GraphicsMagick
 	{
 		Collection<Drawable^>^ drawables = gcnew Collection<Drawable^>();
 
-		for each (XmlElement^ elem in element->SelectNodes("*"))
+		for each (XmlElement^ elem in GetChildren(element))
 		{
-			ExecuteDrawable(elem, drawables);
+			if (_IsTraced)
+				ExecuteTraced(elem, drawables, image);
+			else
+				ExecuteDrawable(elem, drawables);
 		}
 
 		image->Draw(drawables);
 	}
 	//==============================================================================================
+	void MagickScript::ExecuteTraced(XmlElement^ element, MagickImage^ image)
+	{
+		int originalWidth = image->Width;
+		int originalHeight = image->Height;
+		Int64 memoryUsage = GetMemoryUsage();
+		TimeSpan processorTime = ThreadHelper::GetProcessorTime();
+		System::Diagnostics::Stopwatch^ stopwatch = System::Diagnostics::Stopwatch::StartNew();
+
+		ExecuteImage(element, image);
+
+		RaiseTrace(element, stopwatch, processorTime, memoryUsage, originalWidth, originalHeight,
+			image->Width, image->Height);
+	}
+	//==============================================================================================
+	MagickImage^ MagickScript::ExecuteTraced(XmlElement^ element, MagickImageCollection^ collection)
+	{
+		Int64 memoryUsage = GetMemoryUsage();
+		TimeSpan processorTime = ThreadHelper::GetProcessorTime();
+		System::Diagnostics::Stopwatch^ stopwatch = System::Diagnostics::Stopwatch::StartNew();
+
+		MagickImage^ result = Execute(element, collection);
+
+		if (result != nullptr)
+			RaiseTrace(element, stopwatch, processorTime, memoryUsage, 0, 0, result->Width, result->Height);
+		else
+			RaiseTrace(element, stopwatch, processorTime, memoryUsage, 0, 0, 0, 0);
+
+		return result;
+	}
+	//==============================================================================================
+	void MagickScript::ExecuteTraced(XmlElement^ element, Collection<Drawable^>^ drawables,
+		MagickImage^ image)
+	{
+		Int64 memoryUsage = GetMemoryUsage();
+		TimeSpan processorTime = ThreadHelper::GetProcessorTime();
+		System::Diagnostics::Stopwatch^ stopwatch = System::Diagnostics::Stopwatch::StartNew();
+
+		ExecuteDrawable(element, drawables);
+
+		RaiseTrace(element, stopwatch, processorTime, memoryUsage, image->Width, image->Height,
+			image->Width, image->Height);
+	}
+	//==============================================================================================
 	void MagickScript::ExecuteWrite(XmlElement^ element, MagickImage^ image)
 	{
 		String^ fileName = element->GetAttribute("fileName");
@@ -182,24 +379,79 @@ namespace GraphicsMagick
 
 			String^ id = element->GetAttribute("id");
 
+			if (_PendingWrites != nullptr)
+			{
+				_PendingWrites->Add(gcnew ScriptWriteEventArgs(id, image->Clone()));
+				return;
+			}
+
 			ScriptWriteEventArgs^ eventArgs = gcnew ScriptWriteEventArgs(id, image);
 			Write(this, eventArgs);
 		}
 	}
 	//==============================================================================================
+	System::Collections::IEnumerable^ MagickScript::GetChildren(XmlElement^ element)
+	{
+		return _Compiled->GetChildren(element);
+	}
+	//==============================================================================================
+	Int64 MagickScript::GetMemoryUsage()
+	{
+		return MagickLib::GetMagickResource(MagickLib::MemoryResource) +
+			MagickLib::GetMagickResource(MagickLib::MapResource);
+	}
+	//==============================================================================================
 	void MagickScript::Initialize(Stream^ stream)
 	{
 		Throw::IfNull("stream", stream);
 
-		XmlReader^ xmlReader = XmlReader::Create(stream, _ReaderSettings);
-		_Script = gcnew XmlDocument();
-		_Script->Load(xmlReader);
-		delete xmlReader;
+		array<Byte>^ data = MagickReader::Read(stream);
+		String^ key = ScriptCache::GetKey(data);
+
+		CompiledScript^ script = ScriptCache::Get(key);
+		if (script == nullptr)
+		{
+			MemoryStream^ memStream = gcnew MemoryStream(data);
+			try
+			{
+				script = gcnew CompiledScript(Load(memStream));
+			}
+			finally
+			{
+				delete memStream;
+			}
+
+			ScriptCache::Add(key, script);
+		}
 
-		_Variables = gcnew ScriptVariables(_Script);
+		Initialize(script);
+	}
+	//==============================================================================================
+	void MagickScript::Initialize(CompiledScript^ script)
+	{
+		_Compiled = script;
+		_MaxDegreeOfParallelism = 1;
+		_Script = script->Script;
+		_TraceInterval = 1;
+		_Variables = gcnew ScriptVariables(script->VariableNames);
 	}
 	//==============================================================================================
-	void MagickScript::Initialize(XPathNavigator^ navigator)
+	XmlDocument^ MagickScript::Load(Stream^ stream)
+	{
+		XmlReader^ xmlReader = XmlReader::Create(stream, _ReaderSettings);
+		try
+		{
+			XmlDocument^ script = gcnew XmlDocument();
+			script->Load(xmlReader);
+			return script;
+		}
+		finally
+		{
+			delete xmlReader;
+		}
+	}
+	//==============================================================================================
+	XmlDocument^ MagickScript::Load(XPathNavigator^ navigator)
 	{
 		MemoryStream^ memStream = gcnew MemoryStream();
 		XmlWriter^ writer = XmlWriter::Create(memStream);
@@ -208,7 +460,7 @@ namespace GraphicsMagick
 			navigator->WriteSubtree(writer);
 			writer->Flush();
 			memStream->Position = 0;
-			Initialize(memStream);
+			return Load(memStream);
 		}
 		finally
 		{
@@ -231,16 +483,85 @@ namespace GraphicsMagick
 		return true;
 	}
 	//==============================================================================================
+	void MagickScript::RaiseTrace(XmlElement^ element, System::Diagnostics::Stopwatch^ stopwatch,
+		TimeSpan processorTime, Int64 memoryUsage, int originalWidth, int originalHeight, int width, int height)
+	{
+		stopwatch->Stop();
+
+		ScriptTraceEventArgs^ eventArgs = gcnew ScriptTraceEventArgs(element->Name, stopwatch->Elapsed,
+			ThreadHelper::GetProcessorTime() - processorTime, originalWidth, originalHeight, width, height,
+			GetMemoryUsage() - memoryUsage);
+		Trace(this, eventArgs);
+	}
+	//==============================================================================================
+	void MagickScript::RaiseWrites(List<Object^>^ writes)
+	{
+		for each (Object^ write in writes)
+		{
+			ScriptBranch^ branch = dynamic_cast<ScriptBranch^>(write);
+			if (branch == nullptr)
+			{
+				Write(this, (ScriptWriteEventArgs^)write);
+				continue;
+			}
+
+			if (branch->Error != nullptr)
+				throw gcnew MagickErrorException("A clone operation of the script failed: " + branch->Error->Message, branch->Error);
+
+			RaiseWrites(branch->Writes);
+		}
+	}
+	//==============================================================================================
 	generic <class T>
 	void MagickScript::SetArgument(System::Collections::Hashtable^ arguments, XmlAttribute^ attribute)
 	{
 		arguments[attribute->Name] = _Variables->GetValue<T>(attribute);
 	}
 	//==============================================================================================
+	List<Object^>^ MagickScript::StartBranches()
+	{
+		List<Object^>^ previous = _PendingWrites;
+		_PendingWrites = _MaxDegreeOfParallelism > 1 ? gcnew List<Object^>() : nullptr;
+		return previous;
+	}
+	//==============================================================================================
+	bool MagickScript::StartTrace()
+	{
+		bool wasTraced = _IsTraced;
+
+		if (_TraceHandler == nullptr)
+			_IsTraced = false;
+		else
+			_IsTraced = ((unsigned int)Interlocked::Increment(_TraceCount) - 1) % (unsigned int)_TraceInterval == 0;
+
+		return wasTraced;
+	}
+	//==============================================================================================
+	void MagickScript::WaitForBranches(List<Object^>^ writes)
+	{
+		for each (Object^ write in writes)
+		{
+			ScriptBranch^ branch = dynamic_cast<ScriptBranch^>(write);
+			if (branch == nullptr)
+				continue;
+
+			branch->Wait();
+			WaitForBranches(branch->Writes);
+		}
+	}
+	//==============================================================================================
 	MagickScript::MagickScript(IXPathNavigable^ xml)
 	{
 		Throw::IfNull("xml", xml);
-		Initialize(xml->CreateNavigator());
+
+		CompiledScript^ script = ScriptCache::Get(xml);
+		if (script == nullptr)
+		{
+			script = gcnew CompiledScript(Load(xml->CreateNavigator()));
+			ScriptCache::Add(xml, script);
+		}
+
+		Initialize(script);
 	}
 	//==============================================================================================
 	MagickScript::MagickScript(String^ fileName)
@@ -248,9 +569,25 @@ namespace GraphicsMagick
 		String^ filePath = FileHelper::CheckForBaseDirectory(fileName);
 		Throw::IfInvalidFileName(filePath);
 
-		FileStream^ stream = File::OpenRead(filePath);
-		Initialize(stream);
-		delete stream;
+		String^ key = ScriptCache::GetKey(filePath);
+
+		CompiledScript^ script = ScriptCache::Get(key);
+		if (script == nullptr)
+		{
+			FileStream^ stream = File::OpenRead(filePath);
+			try
+			{
+				script = gcnew CompiledScript(Load(stream));
+			}
+			finally
+			{
+				delete stream;
+			}
+
+			ScriptCache::Add(key, script);
+		}
+
+		Initialize(script);
 	}
 	//==============================================================================================
 	MagickScript::MagickScript(Stream^ stream)
@@ -258,6 +595,28 @@ namespace GraphicsMagick
 		Initialize(stream);
 	}
 	//==============================================================================================
+	int MagickScript::MaxDegreeOfParallelism::get()
+	{
+		return _MaxDegreeOfParallelism;
+	}
+	//==============================================================================================
+	void MagickScript::MaxDegreeOfParallelism::set(int value)
+	{
+		Throw::IfTrue("value", value < 1, "The value should be at least 1.");
+		_MaxDegreeOfParallelism = value;
+	}
+	//==============================================================================================
+	int MagickScript::TraceInterval::get()
+	{
+		return _TraceInterval;
+	}
+	//==============================================================================================
+	void MagickScript::TraceInterval::set(int value)
+	{
+		Throw::IfTrue("value", value < 1, "The value should be at least 1.");
+		_TraceInterval = value;
+	}
+	//==============================================================================================
 	ScriptVariables^ MagickScript::Variables::get()
 	{
 		return _Variables;
@@ -278,6 +637,21 @@ namespace GraphicsMagick
 		_ReadHandler -= handler;
 	}
 	//==============================================================================================
+	void MagickScript::Trace::add(EventHandler<ScriptTraceEventArgs^>^ handler)
+	{
+		_TraceHandler += handler;
+	}
+	//==============================================================================================
+	void MagickScript::Trace::raise(Object^ sender, ScriptTraceEventArgs^ arguments)
+	{
+		_TraceHandler(sender, arguments);
+	}
+	//==============================================================================================
+	void MagickScript::Trace::remove(EventHandler<ScriptTraceEventArgs^>^ handler)
+	{
+		_TraceHandler -= handler;
+	}
+	//==============================================================================================
 	void MagickScript::Write::add(EventHandler<ScriptWriteEventArgs^>^ handler)
 	{
 		_WriteHandler += handler;
@@ -293,16 +667,38 @@ namespace GraphicsMagick
 		_WriteHandler -= handler;
 	}
 	//==============================================================================================
+	void MagickScript::Compile()
+	{
+		_Compiled->Compile();
+		_Variables->Compiled = _Compiled;
+	}
+	//==============================================================================================
 	MagickImage^ MagickScript::Execute()
 	{
 		XmlElement^ element = (XmlElement^)_Script->SelectSingleNode("/msl/*");
 
-		if (element->Name == "read")
-			return CreateMagickImage(element);
-		else if (element->Name == "collection")
-			return ExecuteCollection(element);
-		else
+		if (element->Name != "read" && element->Name != "collection")
 			throw gcnew NotImplementedException(element->Name);
+
+		List<Object^>^ previous = StartBranches();
+		bool wasTraced = StartTrace();
+		bool succeeded = false;
+		try
+		{
+			MagickImage^ result;
+			if (element->Name == "read")
+				result = CreateMagickImage(element);
+			else
+				result = ExecuteCollection(element);
+
+			succeeded = true;
+			return result;
+		}
+		finally
+		{
+			_IsTraced = wasTraced;
+			EndBranches(previous, succeeded);
+		}
 	}
 	//==============================================================================================
 	void MagickScript::Execute(MagickImage^ image)
@@ -313,7 +709,68 @@ namespace GraphicsMagick
 		if (element == nullptr)
 			throw gcnew InvalidOperationException("This method only works with a script that contains a single read operation.");
 
-		Execute(element, image);
+		List<Object^>^ previous = StartBranches();
+		bool wasTraced = StartTrace();
+		bool succeeded = false;
+		try
+		{
+			Execute(element, image);
+			succeeded = true;
+		}
+		finally
+		{
+			_IsTraced = wasTraced;
+			EndBranches(previous, succeeded);
+		}
+	}
+	//==============================================================================================
+	IDictionary<String^, Exception^>^ MagickScript::ExecuteBatch(IEnumerable<String^>^ fileNames,
+		int degreeOfParallelism)
+	{
+		Throw::IfNull("fileNames", fileNames);
+		Throw::IfTrue("degreeOfParallelism", degreeOfParallelism < 1, "The value should be at least 1.");
+
+		XmlElement^ element = (XmlElement^)_Script->SelectSingleNode("/msl/read");
+		if (element == nullptr)
+			throw gcnew InvalidOperationException("This method only works with a script that contains a single read operation.");
+
+		// The workers share the attribute value cache instead of each converting the attributes.
+		Compile();
+
+		ScriptBatch^ batch = gcnew ScriptBatch(element, fileNames);
+		try
+		{
+			array<Thread^>^ threads = gcnew array<Thread^>(degreeOfParallelism - 1);
+			try
+			{
+				for (int i = 0; i < threads->Length; i++)
+				{
+					Thread^ thread = gcnew Thread(gcnew ParameterizedThreadStart(this, &MagickScript::ExecuteBatchItems));
+					thread->IsBackground = true;
+					thread->Start(batch);
+					threads[i] = thread;
+				}
+
+				ExecuteBatchItems(batch);
+			}
+			finally
+			{
+				for each (Thread^ thread in threads)
+				{
+					if (thread != nullptr)
+						thread->Join();
+				}
+			}
+
+			if (batch->Error != nullptr)
+				throw gcnew InvalidOperationException("The enumeration of the file names failed: " + batch->Error->Message, batch->Error);
+
+			return batch->Errors;
+		}
+		finally
+		{
+			delete batch;
+		}
 	}
 	//==============================================================================================
 #if !(NET20)
@@ -321,7 +778,7 @@ namespace GraphicsMagick
 	MagickScript::MagickScript(XElement^ xml)
 	{
 		Throw::IfNull("xml", xml);
-		Initialize(System::Xml::XPath::Extensions::CreateNavigator(xml));
+		Initialize(gcnew CompiledScript(Load(System::Xml::XPath::Extensions::CreateNavigator(xml))));
 	}
 	//==============================================================================================
 #endif
@@ -13,7 +13,11 @@
 //=================================================================================================
 #pragma once
 
+#include "CompiledScript.h"
+#include "ScriptBatch.h"
+#include "ScriptBranch.h"
 #include "ScriptReadEventArgs.h"
+#include "ScriptTraceEventArgs.h"
 #include "ScriptVariables.h"
 #include "ScriptWriteEventArgs.h"
 #include "..\MagickImage.h"
@@ -46,9 +50,19 @@ namespace GraphicsMagick
 	private:
 		//===========================================================================================
 		static initonly XmlReaderSettings^ _ReaderSettings = CreateXmlReaderSettings();
+		[ThreadStatic]
+		static bool _IsTraced;
+		[ThreadStatic]
+		static List<Object^>^ _PendingWrites;
 		//===========================================================================================
+		int _ActiveWorkers;
+		CompiledScript^ _Compiled;
+		int _MaxDegreeOfParallelism;
 		EventHandler<ScriptReadEventArgs^>^ _ReadHandler;
 		XmlDocument^ _Script;
+		int _TraceCount;
+		EventHandler<ScriptTraceEventArgs^>^ _TraceHandler;
+		int _TraceInterval;
 		ScriptVariables^ _Variables;
 		EventHandler<ScriptWriteEventArgs^>^ _WriteHandler;
 		//===========================================================================================
@@ -60,27 +74,63 @@ namespace GraphicsMagick
 		//===========================================================================================
 		static XmlReaderSettings^ CreateXmlReaderSettings();
 		//===========================================================================================
+		static void DisposeWrites(List<Object^>^ writes);
+		//===========================================================================================
+		void EndBranches(List<Object^>^ previous, bool succeeded);
+		//===========================================================================================
 		void Execute(XmlElement^ element, MagickImage^ image);
 		//===========================================================================================
 		MagickImage^ Execute(XmlElement^ element, MagickImageCollection^ collection);
 		//===========================================================================================
+		void ExecuteBatchItem(XmlElement^ element, String^ fileName);
+		//===========================================================================================
+		void ExecuteBatchItems(Object^ state);
+		//===========================================================================================
+		void ExecuteBranch(Object^ state);
+		//===========================================================================================
 		void ExecuteClone(XmlElement^ element, MagickImage^ image);
 		//===========================================================================================
 		MagickImage^ ExecuteCollection(XmlElement^ element);
 		//===========================================================================================
 		void ExecuteDraw(XmlElement^ element, MagickImage^ image);
 		//===========================================================================================
+		void ExecuteTraced(XmlElement^ element, MagickImage^ image);
+		//===========================================================================================
+		MagickImage^ ExecuteTraced(XmlElement^ element, MagickImageCollection^ collection);
+		//===========================================================================================
+		void ExecuteTraced(XmlElement^ element, Collection<Drawable^>^ drawables, MagickImage^ image);
+		//===========================================================================================
 		void ExecuteWrite(XmlElement^ element, MagickImage^ image);
 		//===========================================================================================
+		System::Collections::IEnumerable^ GetChildren(XmlElement^ element);
+		//===========================================================================================
+		static Int64 GetMemoryUsage();
+		//===========================================================================================
 		void Initialize(Stream^ stream);
 		//===========================================================================================
-		void Initialize(XPathNavigator^ navigator);
+		void Initialize(CompiledScript^ script);
+		//===========================================================================================
+		static XmlDocument^ Load(Stream^ stream);
+		//===========================================================================================
+		static XmlDocument^ Load(XPathNavigator^ navigator);
 		//===========================================================================================
 		static bool OnlyContains(System::Collections::Hashtable^ arguments, ... array<Object^>^ keys);
 		//===========================================================================================
+		void RaiseTrace(XmlElement^ element, System::Diagnostics::Stopwatch^ stopwatch,
+			TimeSpan processorTime, Int64 memoryUsage, int originalWidth, int originalHeight, int width,
+			int height);
+		//===========================================================================================
+		void RaiseWrites(List<Object^>^ writes);
+		//===========================================================================================
 		generic <class T>
 		void SetArgument(System::Collections::Hashtable^ arguments, XmlAttribute^ attribute);
 		//===========================================================================================
+		List<Object^>^ StartBranches();
+		//===========================================================================================
+		bool StartTrace();
+		//===========================================================================================
+		static void WaitForBranches(List<Object^>^ writes);
+		//===========================================================================================
 #include "Generated\Execute.h"
 		//===========================================================================================
 	public:
@@ -104,6 +154,30 @@ namespace GraphicsMagick
 		MagickScript(Stream^ stream);
 		///==========================================================================================
 		///<summary>
+		/// The maximum number of threads that are used to execute the clone operations of the
+		/// script. When this is more than one the clone operations run in parallel and the Write
+		/// events are raised in the order of the script after the execution has finished. The
+		/// image of the Write event will then be a copy of the image that is disposed after the
+		/// event has been raised. The default value is one.
+		///</summary>
+		property int MaxDegreeOfParallelism
+		{
+			int get();
+			void set(int value);
+		}
+		///==========================================================================================
+		///<summary>
+		/// The interval of the executions that raise the Trace event. When this is more than one
+		/// only every Nth execution of the script is traced, this can be used to sample a script
+		/// that is executed many times. The default value is one.
+		///</summary>
+		property int TraceInterval
+		{
+			int get();
+			void set(int value);
+		}
+		///==========================================================================================
+		///<summary>
 		/// The variables of this script.
 		///</summary>
 		property ScriptVariables^ Variables
@@ -123,6 +197,19 @@ namespace GraphicsMagick
 		}
 		///==========================================================================================
 		///<summary>
+		/// Event that will be raised after each element that was executed on an image, a collection
+		/// or a drawable. Binding this event enables the measurements and should only be used to
+		/// analyze the script.
+		///</summary>
+		event EventHandler<ScriptTraceEventArgs^>^ Trace
+		{
+			void add(EventHandler<ScriptTraceEventArgs^>^ handler);
+			void remove(EventHandler<ScriptTraceEventArgs^>^ handler);
+		private:
+			void raise(Object^ sender, ScriptTraceEventArgs^ arguments);
+		}
+		///==========================================================================================
+		///<summary>
 		/// Event that will be raised when the script needs an image to be written.
 		///</summary>
 		event EventHandler<ScriptWriteEventArgs^>^ Write
@@ -134,6 +221,14 @@ namespace GraphicsMagick
 		}
 		///==========================================================================================
 		///<summary>
+		/// Prepares the script for repeated execution by building an attribute value cache. The
+		/// variable names of all attributes are found once and the attributes that do not contain
+		/// a variable are only converted the first time they are used. The elements of the script
+		/// are still read and dispatched by name during execution.
+		///</summary>
+		void Compile();
+		///==========================================================================================
+		///<summary>
 		/// Executes the script and returns the resulting image.
 		///</summary>
 		MagickImage^ Execute();
@@ -143,6 +238,20 @@ namespace GraphicsMagick
 		///</summary>
 		///<param name="image">The image to execute the script on.</param>
 		void Execute(MagickImage^ image);
+		///==========================================================================================
+		///<summary>
+		/// Executes the script for each of the specified files and returns the errors that occurred.
+		/// The files are executed concurrently and the Write event can be raised from different
+		/// threads. The image of the Write event is disposed after the script has been executed.
+		/// When the enumeration of the file names fails the batch is stopped and the error is thrown
+		/// as the inner exception of an InvalidOperationException. The script is compiled before the
+		/// files are executed, see Compile.
+		///</summary>
+		///<param name="fileNames">The names of the files to execute the script on.</param>
+		///<param name="degreeOfParallelism">The number of files that are executed at the same time.</param>
+		///<returns>The errors of the files that could not be processed, keyed by file name.</returns>
+		///<exception cref="InvalidOperationException"/>
+		IDictionary<String^, Exception^>^ ExecuteBatch(IEnumerable<String^>^ fileNames, int degreeOfParallelism);
 		//===========================================================================================
 #if !(NET20)
 		///==========================================================================================
@@ -0,0 +1,80 @@
+//=================================================================================================
+// Copyright 2014-2015 Dirk Lemstra <https://graphicsmagick.codeplex.com/>
+//
+// Licensed under the ImageMagick License (the "License"); you may not use this file except in 
+// compliance with the License. You may obtain a copy of the License at
+//
+//   http://www.imagemagick.org/script/license.php
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the
+// License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing permissions and
+// limitations under the License.
+//=================================================================================================
+#include "Stdafx.h"
+#include "ScriptBatch.h"
+
+using namespace System::Threading;
+
+namespace GraphicsMagick
+{
+	//==============================================================================================
+	ScriptBatch::ScriptBatch(XmlElement^ element, IEnumerable<String^>^ fileNames)
+	{
+		_Element = element;
+		_Errors = gcnew Dictionary<String^, Exception^>();
+		_FileNames = fileNames->GetEnumerator();
+	}
+	//==============================================================================================
+	XmlElement^ ScriptBatch::Element::get()
+	{
+		return _Element;
+	}
+	//==============================================================================================
+	Exception^ ScriptBatch::Error::get()
+	{
+		return _Error;
+	}
+	//==============================================================================================
+	IDictionary<String^, Exception^>^ ScriptBatch::Errors::get()
+	{
+		return _Errors;
+	}
+	//==============================================================================================
+	void ScriptBatch::AddError(String^ fileName, Exception^ error)
+	{
+		Monitor::Enter(_Errors);
+		try
+		{
+			_Errors[fileName] = error;
+		}
+		finally
+		{
+			Monitor::Exit(_Errors);
+		}
+	}
+	//==============================================================================================
+	bool ScriptBatch::TryGetNext(String^% fileName)
+	{
+		Monitor::Enter(_FileNames);
+		try
+		{
+			if (_Error != nullptr || !_FileNames->MoveNext())
+				return false;
+
+			fileName = _FileNames->Current;
+			return true;
+		}
+		catch (Exception^ exception)
+		{
+			// The batch stops and the error is thrown after all threads have finished.
+			_Error = exception;
+			return false;
+		}
+		finally
+		{
+			Monitor::Exit(_FileNames);
+		}
+	}
+	//==============================================================================================
+}
\ No newline at end of file
@@ -0,0 +1,64 @@
+//=================================================================================================
+// Copyright 2014-2015 Dirk Lemstra <https://graphicsmagick.codeplex.com/>
+//
+// Licensed under the ImageMagick License (the "License"); you may not use this file except in 
+// compliance with the License. You may obtain a copy of the License at
+//
+//   http://www.imagemagick.org/script/license.php
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the
+// License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing permissions and
+// limitations under the License.
+//=================================================================================================
+#pragma once
+
+using namespace System::Collections::Generic;
+using namespace System::Xml;
+
+namespace GraphicsMagick
+{
+	//==============================================================================================
+	private ref class ScriptBatch sealed
+	{
+		//===========================================================================================
+	private:
+		//===========================================================================================
+		XmlElement^ _Element;
+		Exception^ _Error;
+		Dictionary<String^, Exception^>^ _Errors;
+		IEnumerator<String^>^ _FileNames;
+		//===========================================================================================
+	internal:
+		//===========================================================================================
+		ScriptBatch(XmlElement^ element, IEnumerable<String^>^ fileNames);
+		//===========================================================================================
+		property XmlElement^ Element
+		{
+			XmlElement^ get();
+		}
+		//===========================================================================================
+		property Exception^ Error
+		{
+			Exception^ get();
+		}
+		//===========================================================================================
+		property IDictionary<String^, Exception^>^ Errors
+		{
+			IDictionary<String^, Exception^>^ get();
+		}
+		//===========================================================================================
+		void AddError(String^ fileName, Exception^ error);
+		//===========================================================================================
+		bool TryGetNext(String^% fileName);
+		//===========================================================================================
+	public:
+		//===========================================================================================
+		~ScriptBatch()
+		{
+			delete _FileNames;
+		}
+		//===========================================================================================
+	};
+	//==============================================================================================
+}
\ No newline at end of file
@@ -0,0 +1,88 @@
+//=================================================================================================
+// Copyright 2014-2015 Dirk Lemstra <https://graphicsmagick.codeplex.com/>
+//
+// Licensed under the ImageMagick License (the "License"); you may not use this file except in 
+// compliance with the License. You may obtain a copy of the License at
+//
+//   http://www.imagemagick.org/script/license.php
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the
+// License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing permissions and
+// limitations under the License.
+//=================================================================================================
+#include "Stdafx.h"
+#include "ScriptBranch.h"
+
+namespace GraphicsMagick
+{
+	//==============================================================================================
+	ScriptBranch::ScriptBranch(XmlElement^ element, MagickImage^ image)
+	{
+		_Done = gcnew ManualResetEvent(false);
+		_Element = element;
+		_Image = image;
+		_Writes = gcnew List<Object^>();
+	}
+	//==============================================================================================
+	XmlElement^ ScriptBranch::Element::get()
+	{
+		return _Element;
+	}
+	//==============================================================================================
+	Exception^ ScriptBranch::Error::get()
+	{
+		return _Error;
+	}
+	//==============================================================================================
+	void ScriptBranch::Error::set(Exception^ value)
+	{
+		_Error = value;
+	}
+	//==============================================================================================
+	MagickImage^ ScriptBranch::Image::get()
+	{
+		return _Image;
+	}
+	//==============================================================================================
+	bool ScriptBranch::IsPooled::get()
+	{
+		return _IsPooled;
+	}
+	//==============================================================================================
+	void ScriptBranch::IsPooled::set(bool value)
+	{
+		_IsPooled = value;
+	}
+	//==============================================================================================
+	bool ScriptBranch::IsTraced::get()
+	{
+		return _IsTraced;
+	}
+	//==============================================================================================
+	void ScriptBranch::IsTraced::set(bool value)
+	{
+		_IsTraced = value;
+	}
+	//==============================================================================================
+	List<Object^>^ ScriptBranch::Writes::get()
+	{
+		return _Writes;
+	}
+	//==============================================================================================
+	void ScriptBranch::Complete()
+	{
+		_Done->Set();
+	}
+	//==============================================================================================
+	void ScriptBranch::Wait()
+	{
+		if (_Done == nullptr)
+			return;
+
+		_Done->WaitOne();
+		_Done->Close();
+		_Done = nullptr;
+	}
+	//==============================================================================================
+}
\ No newline at end of file
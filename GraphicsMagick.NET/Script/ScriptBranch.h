@@ -0,0 +1,81 @@
+//=================================================================================================
+// Copyright 2014-2015 Dirk Lemstra <https://graphicsmagick.codeplex.com/>
+//
+// Licensed under the ImageMagick License (the "License"); you may not use this file except in 
+// compliance with the License. You may obtain a copy of the License at
+//
+//   http://www.imagemagick.org/script/license.php
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the
+// License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing permissions and
+// limitations under the License.
+//=================================================================================================
+#pragma once
+
+#include "..\MagickImage.h"
+
+using namespace System::Collections::Generic;
+using namespace System::Threading;
+using namespace System::Xml;
+
+namespace GraphicsMagick
+{
+	//==============================================================================================
+	private ref class ScriptBranch sealed
+	{
+		//===========================================================================================
+	private:
+		//===========================================================================================
+		ManualResetEvent^ _Done;
+		XmlElement^ _Element;
+		Exception^ _Error;
+		MagickImage^ _Image;
+		bool _IsPooled;
+		bool _IsTraced;
+		List<Object^>^ _Writes;
+		//===========================================================================================
+	internal:
+		//===========================================================================================
+		ScriptBranch(XmlElement^ element, MagickImage^ image);
+		//===========================================================================================
+		property XmlElement^ Element
+		{
+			XmlElement^ get();
+		}
+		//===========================================================================================
+		property Exception^ Error
+		{
+			Exception^ get();
+			void set(Exception^ value);
+		}
+		//===========================================================================================
+		property MagickImage^ Image
+		{
+			MagickImage^ get();
+		}
+		//===========================================================================================
+		property bool IsPooled
+		{
+			bool get();
+			void set(bool value);
+		}
+		//===========================================================================================
+		property bool IsTraced
+		{
+			bool get();
+			void set(bool value);
+		}
+		//===========================================================================================
+		property List<Object^>^ Writes
+		{
+			List<Object^>^ get();
+		}
+		//===========================================================================================
+		void Complete();
+		//===========================================================================================
+		void Wait();
+		//===========================================================================================
+	};
+	//==============================================================================================
+}
\ No newline at end of file
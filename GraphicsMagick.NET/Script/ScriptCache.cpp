@@ -0,0 +1,161 @@
+//=================================================================================================
+// Copyright 2014-2015 Dirk Lemstra <https://graphicsmagick.codeplex.com/>
+//
+// Licensed under the ImageMagick License (the "License"); you may not use this file except in 
+// compliance with the License. You may obtain a copy of the License at
+//
+//   http://www.imagemagick.org/script/license.php
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the
+// License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing permissions and
+// limitations under the License.
+//=================================================================================================
+#include "Stdafx.h"
+#include "ScriptCache.h"
+
+using namespace System::Globalization;
+using namespace System::IO;
+using namespace System::Security::Cryptography;
+using namespace System::Threading;
+
+namespace GraphicsMagick
+{
+	//==============================================================================================
+#if !(NET20)
+	void ScriptCache::OnDocumentChanged(Object^ sender, XmlNodeChangedEventArgs^)
+	{
+		XmlDocument^ document = (XmlDocument^)sender;
+		document->NodeChanged -= gcnew XmlNodeChangedEventHandler(&ScriptCache::OnDocumentChanged);
+		document->NodeInserted -= gcnew XmlNodeChangedEventHandler(&ScriptCache::OnDocumentChanged);
+		document->NodeRemoved -= gcnew XmlNodeChangedEventHandler(&ScriptCache::OnDocumentChanged);
+
+		_Documents->Remove(document);
+	}
+#endif
+	//==============================================================================================
+#if !(NET20)
+	void ScriptCache::Add(IXPathNavigable^ xml, CompiledScript^ script)
+	{
+		// Only documents that cannot change unnoticed are cached by their identity.
+		XmlDocument^ document = dynamic_cast<XmlDocument^>(xml);
+		if (document != nullptr)
+		{
+			document->NodeChanged += gcnew XmlNodeChangedEventHandler(&ScriptCache::OnDocumentChanged);
+			document->NodeInserted += gcnew XmlNodeChangedEventHandler(&ScriptCache::OnDocumentChanged);
+			document->NodeRemoved += gcnew XmlNodeChangedEventHandler(&ScriptCache::OnDocumentChanged);
+		}
+		else if (dynamic_cast<XPathDocument^>(xml) == nullptr)
+		{
+			return;
+		}
+
+		Monitor::Enter(_Scripts);
+		try
+		{
+			_Documents->Remove(xml);
+			_Documents->Add(xml, script);
+		}
+		finally
+		{
+			Monitor::Exit(_Scripts);
+		}
+	}
+#else
+	void ScriptCache::Add(IXPathNavigable^, CompiledScript^)
+	{
+	}
+#endif
+	//==============================================================================================
+	void ScriptCache::Add(String^ key, CompiledScript^ script)
+	{
+		Monitor::Enter(_Scripts);
+		try
+		{
+			if (_Scripts->ContainsKey(key))
+				return;
+
+			if (_Scripts->Count >= _MaxCount)
+			{
+				_Scripts->Remove(_Keys->Last->Value);
+				_Keys->RemoveLast();
+			}
+
+			_Scripts->Add(key, script);
+			_Keys->AddFirst(key);
+		}
+		finally
+		{
+			Monitor::Exit(_Scripts);
+		}
+	}
+	//==============================================================================================
+#if !(NET20)
+	CompiledScript^ ScriptCache::Get(IXPathNavigable^ xml)
+	{
+		Monitor::Enter(_Scripts);
+		try
+		{
+			CompiledScript^ script;
+			if (_Documents->TryGetValue(xml, script))
+				return script;
+
+			return nullptr;
+		}
+		finally
+		{
+			Monitor::Exit(_Scripts);
+		}
+	}
+#else
+	CompiledScript^ ScriptCache::Get(IXPathNavigable^)
+	{
+		return nullptr;
+	}
+#endif
+	//==============================================================================================
+	CompiledScript^ ScriptCache::Get(String^ key)
+	{
+		Monitor::Enter(_Scripts);
+		try
+		{
+			CompiledScript^ script;
+			if (!_Scripts->TryGetValue(key, script))
+				return nullptr;
+
+			if (_Keys->First->Value != key)
+			{
+				_Keys->Remove(key);
+				_Keys->AddFirst(key);
+			}
+
+			// The scripts never change the document so all the scripts with the same content share
+			// the same instance.
+			return script;
+		}
+		finally
+		{
+			Monitor::Exit(_Scripts);
+		}
+	}
+	//==============================================================================================
+	String^ ScriptCache::GetKey(array<Byte>^ data)
+	{
+		SHA1^ sha1 = SHA1::Create();
+		try
+		{
+			return Convert::ToBase64String(sha1->ComputeHash(data));
+		}
+		finally
+		{
+			delete sha1;
+		}
+	}
+	//==============================================================================================
+	String^ ScriptCache::GetKey(String^ fileName)
+	{
+		return String::Format(CultureInfo::InvariantCulture, "{0}|{1}",
+			Path::GetFullPath(fileName)->ToUpperInvariant(), File::GetLastWriteTimeUtc(fileName).Ticks);
+	}
+	//==============================================================================================
+}
\ No newline at end of file
@@ -0,0 +1,59 @@
+//=================================================================================================
+// Copyright 2014-2015 Dirk Lemstra <https://graphicsmagick.codeplex.com/>
+//
+// Licensed under the ImageMagick License (the "License"); you may not use this file except in 
+// compliance with the License. You may obtain a copy of the License at
+//
+//   http://www.imagemagick.org/script/license.php
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the
+// License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing permissions and
+// limitations under the License.
+//=================================================================================================
+#pragma once
+
+#include "CompiledScript.h"
+
+using namespace System::Collections::Generic;
+using namespace System::Xml;
+using namespace System::Xml::XPath;
+
+#if !(NET20)
+using namespace System::Runtime::CompilerServices;
+#endif
+
+namespace GraphicsMagick
+{
+	//==============================================================================================
+	private ref class ScriptCache abstract sealed
+	{
+		//===========================================================================================
+	private:
+		//===========================================================================================
+		static const int _MaxCount = 128;
+		static initonly LinkedList<String^>^ _Keys = gcnew LinkedList<String^>();
+		static initonly Dictionary<String^, CompiledScript^>^ _Scripts = gcnew Dictionary<String^, CompiledScript^>();
+#if !(NET20)
+		static initonly ConditionalWeakTable<IXPathNavigable^, CompiledScript^>^ _Documents = gcnew ConditionalWeakTable<IXPathNavigable^, CompiledScript^>();
+		//===========================================================================================
+		static void OnDocumentChanged(Object^ sender, XmlNodeChangedEventArgs^ arguments);
+#endif
+		//===========================================================================================
+	internal:
+		//===========================================================================================
+		static void Add(IXPathNavigable^ xml, CompiledScript^ script);
+		//===========================================================================================
+		static void Add(String^ key, CompiledScript^ script);
+		//===========================================================================================
+		static CompiledScript^ Get(IXPathNavigable^ xml);
+		//===========================================================================================
+		static CompiledScript^ Get(String^ key);
+		//===========================================================================================
+		static String^ GetKey(array<Byte>^ data);
+		//===========================================================================================
+		static String^ GetKey(String^ fileName);
+		//===========================================================================================
+	};
+	//==============================================================================================
+}
\ No newline at end of file
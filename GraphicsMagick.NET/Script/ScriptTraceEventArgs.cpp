@@ -0,0 +1,73 @@
+//=================================================================================================
+// Copyright 2014-2015 Dirk Lemstra <https://graphicsmagick.codeplex.com/>
+//
+// Licensed under the ImageMagick License (the "License"); you may not use this file except in 
+// compliance with the License. You may obtain a copy of the License at
+//
+//   http://www.imagemagick.org/script/license.php
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the
+// License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing permissions and
+// limitations under the License.
+//=================================================================================================
+#include "Stdafx.h"
+#include "ScriptTraceEventArgs.h"
+
+namespace GraphicsMagick
+{
+	//==============================================================================================
+	ScriptTraceEventArgs::ScriptTraceEventArgs(String^ name, TimeSpan duration, TimeSpan processorTime,
+		int originalWidth, int originalHeight, int width, int height, Int64 memoryDelta)
+	{
+		_Name = name;
+		_Duration = duration;
+		_ProcessorTime = processorTime;
+		_OriginalWidth = originalWidth;
+		_OriginalHeight = originalHeight;
+		_Width = width;
+		_Height = height;
+		_MemoryDelta = memoryDelta;
+	}
+	//==============================================================================================
+	TimeSpan ScriptTraceEventArgs::Duration::get()
+	{
+		return _Duration;
+	}
+	//==============================================================================================
+	int ScriptTraceEventArgs::Height::get()
+	{
+		return _Height;
+	}
+	//==============================================================================================
+	Int64 ScriptTraceEventArgs::MemoryDelta::get()
+	{
+		return _MemoryDelta;
+	}
+	//==============================================================================================
+	String^ ScriptTraceEventArgs::Name::get()
+	{
+		return _Name;
+	}
+	//==============================================================================================
+	int ScriptTraceEventArgs::OriginalHeight::get()
+	{
+		return _OriginalHeight;
+	}
+	//==============================================================================================
+	int ScriptTraceEventArgs::OriginalWidth::get()
+	{
+		return _OriginalWidth;
+	}
+	//==============================================================================================
+	TimeSpan ScriptTraceEventArgs::ProcessorTime::get()
+	{
+		return _ProcessorTime;
+	}
+	//==============================================================================================
+	int ScriptTraceEventArgs::Width::get()
+	{
+		return _Width;
+	}
+	//==============================================================================================
+}
\ No newline at end of file
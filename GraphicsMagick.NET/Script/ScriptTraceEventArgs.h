@@ -0,0 +1,116 @@
+//=================================================================================================
+// Copyright 2014-2015 Dirk Lemstra <https://graphicsmagick.codeplex.com/>
+//
+// Licensed under the ImageMagick License (the "License"); you may not use this file except in 
+// compliance with the License. You may obtain a copy of the License at
+//
+//   http://www.imagemagick.org/script/license.php
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the
+// License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing permissions and
+// limitations under the License.
+//=================================================================================================
+#pragma once
+
+namespace GraphicsMagick
+{
+	///=============================================================================================
+	///<summary>
+	/// Class that contains data for the Trace event.
+	///</summary>
+	public ref class ScriptTraceEventArgs sealed : EventArgs
+	{
+		//===========================================================================================
+	private:
+		//===========================================================================================
+		TimeSpan _Duration;
+		int _Height;
+		Int64 _MemoryDelta;
+		String^ _Name;
+		int _OriginalHeight;
+		int _OriginalWidth;
+		TimeSpan _ProcessorTime;
+		int _Width;
+		//===========================================================================================
+	internal:
+		//===========================================================================================
+		ScriptTraceEventArgs(String^ name, TimeSpan duration, TimeSpan processorTime,
+			int originalWidth, int originalHeight, int width, int height, Int64 memoryDelta);
+		//===========================================================================================
+	public:
+		///==========================================================================================
+		///<summary>
+		/// The time it took to execute the element.
+		///</summary>
+		property TimeSpan Duration
+		{
+			TimeSpan get();
+		}
+		///==========================================================================================
+		///<summary>
+		/// The height of the image after the element was executed. This is zero for the elements of
+		/// a collection that do not return an image.
+		///</summary>
+		property int Height
+		{
+			int get();
+		}
+		///==========================================================================================
+		///<summary>
+		/// The change in bytes of the memory and the memory-mapped files that GraphicsMagick uses for
+		/// pixel caches. This is measured for the whole process and includes the images of the other
+		/// threads.
+		///</summary>
+		property Int64 MemoryDelta
+		{
+			Int64 get();
+		}
+		///==========================================================================================
+		///<summary>
+		/// The name of the element.
+		///</summary>
+		property String^ Name
+		{
+			String^ get();
+		}
+		///==========================================================================================
+		///<summary>
+		/// The height of the image before the element was executed. This is zero for the elements
+		/// of a collection.
+		///</summary>
+		property int OriginalHeight
+		{
+			int get();
+		}
+		///==========================================================================================
+		///<summary>
+		/// The width of the image before the element was executed. This is zero for the elements of
+		/// a collection.
+		///</summary>
+		property int OriginalWidth
+		{
+			int get();
+		}
+		///==========================================================================================
+		///<summary>
+		/// The processor time that was used by the thread that executed the element. This does not
+		/// include the time of the threads that GraphicsMagick uses internally.
+		///</summary>
+		property TimeSpan ProcessorTime
+		{
+			TimeSpan get();
+		}
+		///==========================================================================================
+		///<summary>
+		/// The width of the image after the element was executed. This is zero for the elements of
+		/// a collection that do not return an image.
+		///</summary>
+		property int Width
+		{
+			int get();
+		}
+		//===========================================================================================
+	};
+	//==============================================================================================
+}
\ No newline at end of file
@@ -0,0 +1,86 @@
+//=================================================================================================
+// Copyright 2014-2015 Dirk Lemstra <https://graphicsmagick.codeplex.com/>
+//
+// Licensed under the ImageMagick License (the "License"); you may not use this file except in 
+// compliance with the License. You may obtain a copy of the License at
+//
+//   http://www.imagemagick.org/script/license.php
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the
+// License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing permissions and
+// limitations under the License.
+//=================================================================================================
+#include "Stdafx.h"
+#include "ScriptTraceSummary.h"
+
+using namespace System::Globalization;
+using namespace System::Text;
+using namespace System::Threading;
+
+namespace GraphicsMagick
+{
+	//==============================================================================================
+	ScriptTraceSummary::ScriptTraceSummary()
+	{
+		_Entries = gcnew Dictionary<String^, array<Int64>^>();
+		_Names = gcnew List<String^>();
+	}
+	//==============================================================================================
+	void ScriptTraceSummary::Add(Object^, ScriptTraceEventArgs^ arguments)
+	{
+		Throw::IfNull("arguments", arguments);
+
+		Monitor::Enter(_Entries);
+		try
+		{
+			array<Int64>^ entry;
+			if (!_Entries->TryGetValue(arguments->Name, entry))
+			{
+				entry = gcnew array<Int64>(4);
+				_Entries[arguments->Name] = entry;
+				_Names->Add(arguments->Name);
+			}
+
+			entry[0]++;
+			entry[1] += arguments->Duration.Ticks;
+			entry[2] += arguments->ProcessorTime.Ticks;
+			entry[3] += arguments->MemoryDelta;
+		}
+		finally
+		{
+			Monitor::Exit(_Entries);
+		}
+	}
+	//==============================================================================================
+	String^ ScriptTraceSummary::ToString()
+	{
+		String^ format = "{0,-24}{1,8}{2,16:F3}{3,16:F3}{4,16}";
+
+		StringBuilder^ result = gcnew StringBuilder();
+		result->AppendFormat(CultureInfo::InvariantCulture, format, "Element", "Count", "Duration (ms)",
+			"Processor (ms)", "Memory");
+		result->AppendLine();
+
+		Monitor::Enter(_Entries);
+		try
+		{
+			for each (String^ name in _Names)
+			{
+				array<Int64>^ entry = _Entries[name];
+
+				result->AppendFormat(CultureInfo::InvariantCulture, format, name, entry[0],
+					TimeSpan::FromTicks(entry[1]).TotalMilliseconds,
+					TimeSpan::FromTicks(entry[2]).TotalMilliseconds, entry[3]);
+				result->AppendLine();
+			}
+		}
+		finally
+		{
+			Monitor::Exit(_Entries);
+		}
+
+		return result->ToString();
+	}
+	//==============================================================================================
+}
\ No newline at end of file
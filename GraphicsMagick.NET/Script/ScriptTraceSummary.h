@@ -0,0 +1,57 @@
+//=================================================================================================
+// Copyright 2014-2015 Dirk Lemstra <https://graphicsmagick.codeplex.com/>
+//
+// Licensed under the ImageMagick License (the "License"); you may not use this file except in 
+// compliance with the License. You may obtain a copy of the License at
+//
+//   http://www.imagemagick.org/script/license.php
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the
+// License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing permissions and
+// limitations under the License.
+//=================================================================================================
+#pragma once
+
+#include "ScriptTraceEventArgs.h"
+
+using namespace System::Collections::Generic;
+
+namespace GraphicsMagick
+{
+	///=============================================================================================
+	///<summary>
+	/// Class that can be used to create a summary of the Trace events of one or more scripts.
+	///</summary>
+	public ref class ScriptTraceSummary sealed
+	{
+		//===========================================================================================
+	private:
+		//===========================================================================================
+		Dictionary<String^, array<Int64>^>^ _Entries;
+		List<String^>^ _Names;
+		//===========================================================================================
+	public:
+		///==========================================================================================
+		///<summary>
+		/// Initializes a new instance of the ScriptTraceSummary class.
+		///</summary>
+		ScriptTraceSummary();
+		///==========================================================================================
+		///<summary>
+		/// Adds the data of the specified Trace event to the summary. This method can be bound
+		/// to the Trace event of a script.
+		///</summary>
+		///<param name="sender">The object that raised the event.</param>
+		///<param name="arguments">The data of the Trace event.</param>
+		void Add(Object^ sender, ScriptTraceEventArgs^ arguments);
+		///==========================================================================================
+		///<summary>
+		/// Returns a table with the number of executions, the duration, the processor time and the
+		/// memory delta of each element.
+		///</summary>
+		virtual String^ ToString() override;
+		//===========================================================================================
+	};
+	//==============================================================================================
+}
\ No newline at end of file
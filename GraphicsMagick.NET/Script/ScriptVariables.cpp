@@ -21,27 +21,6 @@ using namespace System::Globalization;
 
 namespace GraphicsMagick
 {
-	//==============================================================================================
-	void ScriptVariables::GetNames(XmlElement^ element)
-	{
-		for each(XmlAttribute^ attribute in element->Attributes)
-		{
-			array<String^>^ names = GetNames(attribute->Value);
-			if (names == nullptr)
-				continue;
-
-			for each(String^ name in names)
-			{
-				_Variables[name] = nullptr;
-			}
-		}
-
-		for each(XmlNode^ child in element->ChildNodes)
-		{
-			if (child->GetType() == XmlElement::typeid)
-				GetNames((XmlElement^)child);
-		}
-	}
 	//==============================================================================================
 	array<String^>^ ScriptVariables::GetNames(String^ value)
 	{
@@ -61,10 +40,19 @@ namespace GraphicsMagick
 		return result;
 	}
 	//==============================================================================================
-	ScriptVariables::ScriptVariables(XmlDocument^ script)
+	ScriptVariables::ScriptVariables(IEnumerable<String^>^ names)
 	{
 		_Variables = gcnew Dictionary<String^, Object^>();
-		GetNames(script->DocumentElement);
+
+		for each(String^ name in names)
+		{
+			_Variables[name] = nullptr;
+		}
+	}
+	//==============================================================================================
+	void ScriptVariables::Compiled::set(CompiledScript^ value)
+	{
+		_Compiled = value;
 	}
 	//==============================================================================================
 	array<double>^ ScriptVariables::GetDoubleArray(XmlElement^ element)
@@ -92,9 +80,22 @@ namespace GraphicsMagick
 		if (attribute == nullptr)
 			return T();
 
-		array<String^>^ names = GetNames(attribute->Value);
+		array<String^>^ names;
+		if (_Compiled == nullptr || !_Compiled->TryGetNames(attribute, names))
+			names = GetNames(attribute->Value);
+
 		if (names == nullptr)
-			return XmlHelper::GetValue<T>(attribute);
+		{
+			Object^ compiledValue;
+			if (_Compiled != nullptr && _Compiled->TryGetValue(attribute, compiledValue))
+				return (T)compiledValue;
+
+			T value = XmlHelper::GetValue<T>(attribute);
+			if (_Compiled != nullptr)
+				_Compiled->SetValue(attribute, value);
+
+			return value;
+		}
 
 		if (T::typeid == String::typeid)
 		{
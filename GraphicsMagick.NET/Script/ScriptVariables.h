@@ -13,6 +13,8 @@
 //=================================================================================================
 #pragma once
 
+#include "CompiledScript.h"
+
 using namespace System::Collections::Generic;
 using namespace System::Xml;
 using namespace System::Text::RegularExpressions;
@@ -30,18 +32,22 @@ namespace GraphicsMagick
 		//===========================================================================================
 		static initonly Regex^ _Names = gcnew Regex("\\{[$](?<name>[0-9a-zA-Z_-]{1,16})\\}", RegexOptions::Compiled);
 		//===========================================================================================
+		CompiledScript^ _Compiled;
 		Dictionary<String^, Object^>^ _Variables;
 		//===========================================================================================
-		void GetNames(XmlElement^ script);
-		//===========================================================================================
-		static array<String^>^ GetNames(String^ value);
-		//===========================================================================================
 	internal:
 		//===========================================================================================
-		ScriptVariables(XmlDocument^ script);
+		ScriptVariables(IEnumerable<String^>^ names);
+		//===========================================================================================
+		property CompiledScript^ Compiled
+		{
+			void set(CompiledScript^ value);
+		}
 		//===========================================================================================
 		array<double>^ GetDoubleArray(XmlElement^ element);
 		//===========================================================================================
+		static array<String^>^ GetNames(String^ value);
+		//===========================================================================================
 		generic <class T>
 		T GetValue(XmlAttribute^ attribute);
 		//===========================================================================================
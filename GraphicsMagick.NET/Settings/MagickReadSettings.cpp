@@ -15,6 +15,7 @@
 #include "MagickReadSettings.h"
 
 using namespace System::Globalization;
+using namespace System::Text;
 
 namespace GraphicsMagick
 {
@@ -124,4 +125,21 @@ namespace GraphicsMagick
 		_Defines[Enum::GetName(MagickFormat::typeid, format) + ":" + name] = value;
 	}
 	//==============================================================================================
+	String^ MagickReadSettings::ToString()
+	{
+		StringBuilder^ result = gcnew StringBuilder();
+		result->Append(ColorSpace.ToString())->Append('|');
+		result->Append(Density == nullptr ? "" : Density->ToString())->Append('|');
+		result->Append(Format.ToString())->Append('|');
+		result->Append(Width.ToString())->Append('x')->Append(Height.ToString())->Append('|');
+		result->Append(UseMonochrome.ToString());
+
+		List<String^>^ defines = gcnew List<String^>(_Defines->Keys);
+		defines->Sort(StringComparer::Ordinal);
+		for each (String^ define in defines)
+			result->Append('|')->Append(define)->Append('=')->Append(_Defines[define]);
+
+		return result->ToString();
+	}
+	//==============================================================================================
 }
\ No newline at end of file
@@ -15,6 +15,7 @@
 
 #include "..\Arguments\MagickGeometry.h"
 #include "..\Enums\ColorSpace.h"
+#include "..\Enums\DecodedCachePolicy.h"
 #include "..\Enums\MagickFormat.h"
 #include "PixelStorageSettings.h"
 
@@ -68,6 +69,16 @@ namespace GraphicsMagick
 		property Nullable<ColorSpace> ColorSpace;
 		///==========================================================================================
 		///<summary>
+		/// The directory that contains the decoded cache (MPC files) of the images that are read.
+		///</summary>
+		property String^ DecodedCacheDirectory;
+		///==========================================================================================
+		///<summary>
+		/// Specifies how the decoded cache is used when an image is read from a file.
+		///</summary>
+		property DecodedCachePolicy DecodedCachePolicy;
+		///==========================================================================================
+		///<summary>
 		/// Vertical and horizontal resolution in pixels.
 		///</summary>
 		property MagickGeometry^ Density;
@@ -105,6 +116,12 @@ namespace GraphicsMagick
 		///<param name="name">The name of the option.</param>
 		///<param name="value">The value of the option.</param>
 		void SetDefine(MagickFormat format, String^ name, String^ value);
+		///==========================================================================================
+		///<summary>
+		/// Returns a string that represents the current settings. Settings with the same values and
+		/// defines return the same string.
+		///</summary>
+		virtual String^ ToString() override;
 		//===========================================================================================
 	};
 	//==============================================================================================
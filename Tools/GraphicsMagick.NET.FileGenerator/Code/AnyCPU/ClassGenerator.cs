@@ -547,7 +547,7 @@ namespace GraphicsMagick.NET.FileGenerator
 		private bool WriteIEnumerableParameter(IndentedTextWriter writer, ParameterInfo parameter)
 		{
 			Type type = GetIEnumerable(parameter);
-			if (type == null)
+			if (type == null || !_Types.Contains(type))
 				return false;
 
 			WriteType(writer, type);
@@ -789,7 +789,7 @@ namespace GraphicsMagick.NET.FileGenerator
 					writer.Write(", ");
 
 				Type type = GetIEnumerable(parameters[i]);
-				if (type != null)
+				if (type != null && _Types.Contains(type))
 				{
 					writer.Write("Types.IEnumerable");
 					WriteType(writer, type);
@@ -1062,7 +1062,7 @@ namespace GraphicsMagick.NET.FileGenerator
 			else if (!_Types.Contains(type))
 			{
 				writer.Write("typeof(");
-				writer.Write(type.Name);
+				WriteType(writer, type);
 				writer.Write(")");
 			}
 			else